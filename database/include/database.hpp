@@ -1,4 +1,5 @@
 #pragma once
+#include "revil/hashreg.hpp"
 #include "revil/platform.hpp"
 #include <cstring>
 #include <span>
@@ -24,6 +25,43 @@ template <class C> struct Array {
   const C *end() const { return begin() + numItems; }
 };
 
+constexpr uint32 PerfectHashMix(uint32 key, uint32 seed) {
+  key ^= seed * 0x9E3779B9;
+  key ^= key >> 16;
+  key *= 0x85EBCA6B;
+  key ^= key >> 13;
+  key *= 0xC2B2AE35;
+  key ^= key >> 16;
+  return key;
+}
+
+// Maps hash into [0, range)
+constexpr uint32 PerfectHashRange(uint32 hash, uint32 range) {
+  return (uint64(hash) * range) >> 32;
+}
+
+// Minimal perfect hash index into sorted item array
+// bucket = Mix(key, 0), item index = slots[Mix(key, seeds[bucket])]
+struct PerfectHash {
+  Pointer<uint16> seeds;
+  Pointer<uint32> slots;
+  uint32 numSeeds;
+  uint32 numSlots;
+
+  // Returns -1 for empty set, otherwise index of item with key.
+  // Keys outside of set yield arbitrary index, item must be verified.
+  uint32 Find(uint32 key) const {
+    if (!numSlots) {
+      return -1;
+    }
+
+    const uint16 seed =
+        seeds.operator->()[PerfectHashRange(PerfectHashMix(key, 0), numSeeds)];
+    return slots
+        .operator->()[PerfectHashRange(PerfectHashMix(key, seed), numSlots)];
+  }
+};
+
 struct Class {
   uint32 hash;
   StringEntry name;
@@ -39,6 +77,7 @@ struct Fixup {
   Pointer<ResourceClass> classes;
   uint8 platform;
   uint16 numItems;
+  PerfectHash lookup;
 };
 
 struct Extension {
@@ -90,8 +129,26 @@ struct Header {
   Array<Extension> extensions[2];
   Array<Extension4> extensions4[2];
   Array<ExtensionN> extensionsN;
+  PerfectHash resourceClassesLookup[NUM_PLATFORMS];
+  // Keys are MTHashV2 of extension or title
+  PerfectHash extensionsLookup[2];
+  PerfectHash extensions4Lookup[2];
+  PerfectHash extensionsNLookup;
+  PerfectHash titlesLookup;
+};
+
+// Standalone registry file written by make_db, Header data follows
+struct BlobHeader {
+  static constexpr uint32 ID = CompileFourCC("REDB");
+  // Increment on any layout change of database structures
+  static constexpr uint32 VERSION = 1;
+  uint32 id = ID;
+  uint32 version = VERSION;
+  uint64 dataSize;
 };
 
+static_assert(sizeof(BlobHeader) % 8 == 0);
+
 inline bool operator<(const StringEntry &e, std::string_view sv) {
   if (e.size == sv.size()) {
     return std::string_view(e) < sv;
@@ -129,24 +186,109 @@ const OutKey *LowerBound(const Key &key, const ArrayType<OutKey> &items) {
   return base;
 }
 
+// Uses lookup if available, otherwise binary search
+template <class C>
+const C *FindExtension(const Array<C> &items, const PerfectHash &lookup,
+                       std::string_view key) {
+  if (lookup.numSlots) {
+    const uint32 index = lookup.Find(MTHashV2(key));
+
+    if (index < items.numItems &&
+        std::string_view(items.begin()[index].extension) == key) {
+      return items.begin() + index;
+    }
+
+    return nullptr;
+  }
+
+  if (auto found = LowerBound(key, items);
+      found != items.end() && found->extension == key) {
+    return found;
+  }
+
+  return nullptr;
+}
+
+inline const TitleName *FindTitle(const Header &hdr, std::string_view title) {
+  if (hdr.titlesLookup.numSlots) {
+    const uint32 index = hdr.titlesLookup.Find(MTHashV2(title));
+
+    if (index < hdr.titles.numItems &&
+        std::string_view(hdr.titles.begin()[index].name) == title) {
+      return hdr.titles.begin() + index;
+    }
+
+    return nullptr;
+  }
+
+  if (auto found = LowerBound(title, hdr.titles);
+      found != hdr.titles.end() && std::string_view(found->name) == title) {
+    return found;
+  }
+
+  return nullptr;
+}
+
+inline const ResourceClass *FindResourceClass(const Header &hdr, uint32 hash,
+                                              uint8 platform) {
+  auto &classes = hdr.resourceClasses[platform];
+
+  if (auto &lookup = hdr.resourceClassesLookup[platform]; lookup.numSlots) {
+    const uint32 index = lookup.Find(hash);
+
+    if (index < classes.numItems && classes.begin()[index].hash == hash) {
+      return classes.begin() + index;
+    }
+
+    return nullptr;
+  }
+
+  if (auto found = LowerBound(hash, classes);
+      found != classes.end() && found->hash == hash) {
+    return found;
+  }
+
+  return nullptr;
+}
+
+inline const ResourceClass *FindFixupClass(const Fixup &fixup, uint32 hash) {
+  const ResourceClass *classes = fixup.classes.operator->();
+
+  if (fixup.lookup.numSlots) {
+    const uint32 index = fixup.lookup.Find(hash);
+
+    if (index < fixup.numItems && classes[index].hash == hash) {
+      return classes + index;
+    }
+
+    return nullptr;
+  }
+
+  for (size_t i = 0; i < fixup.numItems; i++) {
+    if (classes[i].hash == hash) {
+      return classes + i;
+    }
+  }
+
+  return nullptr;
+}
+
 std::span<const uint32> ClassesFromExtension(const Header &hdr,
                                              std::string_view ext,
                                              bool version1 = false) {
-  if (auto foundExt = LowerBound(ext, hdr.extensions[version1]);
-      foundExt != hdr.extensions[version1].end() &&
-      foundExt->extension == ext) {
+  if (auto foundExt = FindExtension(hdr.extensions[version1],
+                                    hdr.extensionsLookup[version1], ext)) {
     return {&foundExt->hash, 1};
   }
 
-  if (auto foundExt = LowerBound(ext, hdr.extensions4[version1]);
-      foundExt != hdr.extensions4[version1].end() &&
-      foundExt->extension == ext) {
+  if (auto foundExt = FindExtension(hdr.extensions4[version1],
+                                    hdr.extensions4Lookup[version1], ext)) {
     return {foundExt->hashes, 4};
   }
 
   if (!version1) {
-    if (auto foundExt = LowerBound(ext, hdr.extensionsN);
-        foundExt != hdr.extensionsN.end() && foundExt->extension == ext) {
+    if (auto foundExt =
+            FindExtension(hdr.extensionsN, hdr.extensionsNLookup, ext)) {
       return {foundExt->hashes.operator->(), foundExt->hashes.size};
     }
   }
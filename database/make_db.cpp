@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <array>
 #include <functional>
+#include <numeric>
 #include <set>
 #include <sstream>
 
@@ -302,6 +303,106 @@ using CompareString = decltype([](auto &i1, auto &i2) {
   return i1.size() > i2.size();
 });
 
+// Minimal perfect hash of keys, keys[i] belongs to item i
+// Duplicate keys are resolved to their first item
+// Pointers are absolute stream offsets until RelocatePerfectHash
+PerfectHash WritePerfectHash(BinWritterRef wr,
+                             const std::vector<uint32> &keys) {
+  std::map<uint32, uint32> uniqueKeys;
+
+  for (uint32 i = 0; i < keys.size(); i++) {
+    uniqueKeys.emplace(keys[i], i);
+  }
+
+  if (uniqueKeys.empty()) {
+    return {};
+  }
+
+  const uint32 numSlots = uniqueKeys.size();
+  // Average of 3 keys per bucket
+  const uint32 numSeeds = (numSlots + 2) / 3;
+  std::vector<std::vector<std::pair<uint32, uint32>>> buckets(numSeeds);
+
+  for (auto &[key, index] : uniqueKeys) {
+    buckets.at(PerfectHashRange(PerfectHashMix(key, 0), numSeeds))
+        .emplace_back(key, index);
+  }
+
+  std::vector<uint32> order(numSeeds);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](uint32 b0, uint32 b1) {
+    return buckets[b0].size() > buckets[b1].size();
+  });
+
+  std::vector<uint16> seeds(numSeeds);
+  std::vector<uint32> slots(numSlots);
+  std::vector<bool> usedSlots(numSlots);
+  std::vector<uint32> bucketSlots;
+
+  for (uint32 b : order) {
+    auto &bucket = buckets[b];
+
+    if (bucket.empty()) {
+      break;
+    }
+
+    uint32 seed = 1;
+
+    for (; seed < 0x10000; seed++) {
+      bucketSlots.clear();
+
+      for (auto &[key, index] : bucket) {
+        const uint32 slot =
+            PerfectHashRange(PerfectHashMix(key, seed), numSlots);
+
+        if (usedSlots[slot] || std::find(bucketSlots.begin(),
+                                         bucketSlots.end(),
+                                         slot) != bucketSlots.end()) {
+          break;
+        }
+
+        bucketSlots.push_back(slot);
+      }
+
+      if (bucketSlots.size() == bucket.size()) {
+        break;
+      }
+    }
+
+    if (seed == 0x10000) {
+      throw es::RuntimeError("Cannot create perfect hash");
+    }
+
+    seeds[b] = seed;
+
+    for (size_t k = 0; k < bucket.size(); k++) {
+      usedSlots[bucketSlots[k]] = true;
+      slots[bucketSlots[k]] = bucket[k].second;
+    }
+  }
+
+  PerfectHash retVal{
+      .seeds{.varPtr = int32(wr.Tell())},
+      .numSeeds = numSeeds,
+      .numSlots = numSlots,
+  };
+  wr.WriteContainer(seeds);
+  wr.ApplyPadding(4);
+  retVal.slots.varPtr = wr.Tell();
+  wr.WriteContainer(slots);
+
+  return retVal;
+}
+
+void RelocatePerfectHash(PerfectHash &phf, size_t phfOffset) {
+  if (!phf.numSlots) {
+    return;
+  }
+
+  phf.seeds.varPtr -= phfOffset + offsetof(PerfectHash, seeds);
+  phf.slots.varPtr -= phfOffset + offsetof(PerfectHash, slots);
+}
+
 auto DoStrings(BinWritterRef wr) {
   std::map<std::string_view, uint32> sliderOffsets;
   std::set<std::string_view, CompareString> strings;
@@ -903,12 +1004,21 @@ DoTitleFixups(BinWritterRef wr, size_t indicesBegin, const Header *hdr,
 
         wr.Write(c);
       }
+
+      std::vector<uint32> keys;
+
+      for (auto &c : fix) {
+        keys.push_back(c.hash);
+      }
+
+      platformFixups.back().lookup = WritePerfectHash(wr, keys);
     }
 
     const int32 fixupsBegin = wr.Tell();
 
     for (auto &f : platformFixups) {
       f.classes.varPtr -= wr.Tell();
+      RelocatePerfectHash(f.lookup, wr.Tell() + offsetof(Fixup, lookup));
       wr.Write(f);
     }
 
@@ -932,9 +1042,9 @@ DoTitleFixups(BinWritterRef wr, size_t indicesBegin, const Header *hdr,
 void ValidateDb(const Header *shdr) {
   for (auto &d : GLOBAL_DB) {
     for (auto &t : d.titles) {
-      auto oKey = LowerBound(t, shdr->titles);
+      auto oKey = FindTitle(*shdr, t);
 
-      if (oKey == shdr->titles.end() || std::string_view(oKey->name) != t) {
+      if (!oKey) {
         throw es::RuntimeError("Cannot find title");
       }
 
@@ -1019,21 +1129,12 @@ void ValidateDb(const Header *shdr) {
 
           for (auto &f : title.fixups) {
             if (f.platform == p) {
-              [&] {
-                const ResourceClass *fClasses = f.classes.operator->();
-
-                for (size_t i = 0; i < f.numItems; i++) {
-                  if (fClasses[i].hash == hash) {
-                    if (std::string_view(fClasses[i].extension) !=
-                        c.extension) {
-                      throw es::RuntimeError("Validation error");
-                    }
-                    found = true;
-                    return;
-                  }
+              if (auto fClass = FindFixupClass(f, hash)) {
+                if (std::string_view(fClass->extension) != c.extension) {
+                  throw es::RuntimeError("Validation error");
                 }
-                return;
-              }();
+                found = true;
+              }
             }
           }
 
@@ -1041,13 +1142,12 @@ void ValidateDb(const Header *shdr) {
             continue;
           }
 
-          auto foundClass = LowerBound(hash, shdr->resourceClasses[p]);
+          auto foundClass = FindResourceClass(*shdr, hash, p);
 
-          if (foundClass == shdr->resourceClasses[p].end() ||
-              foundClass->hash != hash) {
-            foundClass = LowerBound(hash, shdr->resourceClasses[0]);
+          if (!foundClass) {
+            foundClass = FindResourceClass(*shdr, hash, 0);
 
-            if (foundClass == shdr->resourceClasses[0].end()) {
+            if (!foundClass) {
               throw es::RuntimeError("Validation error");
             }
           }
@@ -1082,6 +1182,76 @@ void ValidateDb(const Header *shdr) {
   }
 }
 
+template <class Titles>
+void DoLookups(BinWritterRef wr, std::stringstream &str, Header &hdr,
+               const Titles &titles) {
+  std::vector<uint32> resourceKeys[NUM_PLATFORMS];
+  std::vector<uint32> extensionKeys[2];
+  std::vector<uint32> extension4Keys[2];
+  std::vector<uint32> extensionNKeys;
+  std::vector<uint32> titleKeys;
+
+  {
+    // Stream buffer is reallocated by following writes
+    const Header *shdr =
+        reinterpret_cast<const Header *>(str.rdbuf()->view().data());
+
+    for (uint32 p = 0; p < NUM_PLATFORMS; p++) {
+      for (auto &c : shdr->resourceClasses[p]) {
+        resourceKeys[p].push_back(c.hash);
+      }
+    }
+
+    for (uint32 v = 0; v < 2; v++) {
+      for (auto &e : shdr->extensions[v]) {
+        extensionKeys[v].push_back(MTHashV2(e.extension));
+      }
+
+      for (auto &e : shdr->extensions4[v]) {
+        extension4Keys[v].push_back(MTHashV2(e.extension));
+      }
+    }
+
+    for (auto &e : shdr->extensionsN) {
+      extensionNKeys.push_back(MTHashV2(e.extension));
+    }
+  }
+
+  for (auto &[tit, _] : titles) {
+    titleKeys.push_back(MTHashV2(tit));
+  }
+
+  auto Write = [&](PerfectHash &phf, const std::vector<uint32> &keys,
+                   size_t phfOffset, bool uniqueKeys) {
+    if (uniqueKeys && std::set<uint32>(keys.begin(), keys.end()).size() !=
+                          keys.size()) {
+      throw es::RuntimeError("Lookup key collision");
+    }
+
+    phf = WritePerfectHash(wr, keys);
+    RelocatePerfectHash(phf, phfOffset);
+  };
+
+  for (uint32 p = 0; p < NUM_PLATFORMS; p++) {
+    Write(hdr.resourceClassesLookup[p], resourceKeys[p],
+          offsetof(Header, resourceClassesLookup[0]) + sizeof(PerfectHash) * p,
+          false);
+  }
+
+  for (uint32 v = 0; v < 2; v++) {
+    Write(hdr.extensionsLookup[v], extensionKeys[v],
+          offsetof(Header, extensionsLookup[0]) + sizeof(PerfectHash) * v,
+          true);
+    Write(hdr.extensions4Lookup[v], extension4Keys[v],
+          offsetof(Header, extensions4Lookup[0]) + sizeof(PerfectHash) * v,
+          true);
+  }
+
+  Write(hdr.extensionsNLookup, extensionNKeys,
+        offsetof(Header, extensionsNLookup), true);
+  Write(hdr.titlesLookup, titleKeys, offsetof(Header, titlesLookup), true);
+}
+
 int main() {
   LoadDb();
 
@@ -1129,12 +1299,11 @@ int main() {
     wr.Write(res);
   }
 
+  DoLookups(wr, str, hdr, titles);
+
   wr.Seek(0);
   wr.Write(hdr);
 
-  // BinWritter wrn("database/redb");
-  // wrn.WriteContainer(str.rdbuf()->view());
-
   const uint64 *oData =
       reinterpret_cast<const uint64 *>(str.rdbuf()->view().data());
   const size_t numItems = (str.rdbuf()->view().size() + 7) / 8;
@@ -1158,5 +1327,11 @@ int main() {
 
   ostr << "};\n";
 
+  // Runtime loadable copy, see revil::LoadRegistry
+  BinWritter wrn("database/redb.bin");
+  wrn.Write(BlobHeader{.dataSize = numItems * 8});
+  wrn.WriteContainer(str.rdbuf()->view());
+  wrn.ApplyPadding(8);
+
   return 0;
 }
@@ -22,7 +22,12 @@
 #include "spike/except.hpp"
 #include "spike/io/bincore_fwd.hpp"
 #include <functional>
+#include <memory>
 #include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace revil {
 struct ArcExtractContext : AppExtractContext {
@@ -39,9 +44,114 @@ struct ArcExtractContext : AppExtractContext {
   }
 };
 
+enum class ArcOutputOrder : uint8 {
+  Toc,        // Entries are sent in the same order as they are in archive
+  Completion, // Entries are sent as soon as they are decompressed
+};
+
+// Glob patterns matched against archive paths with resolved extension.
+// Matching is case insensitive and treats '\\' and '/' as the same separator.
+// '*' matches within one folder, '**' across folders, '?' any single character.
+// Pattern also matches every path inside the folder it matches and
+// the file it matches without extension.
+struct RE_EXTERN ArcPathFilter {
+  // Empty = include all
+  std::vector<std::string> include;
+  std::vector<std::string> exclude;
+
+  bool Accepts(std::string_view path) const;
+};
+
+struct ArcEnumerateSettings {
+  // Number of decompression workers, 0 = hardware concurrency, 1 = serial
+  uint32 numThreads = 1;
+  // Upper limit of buffered bytes for entries that are read but not sent yet
+  size_t memoryBudget = 0x10000000;
+  ArcOutputOrder order = ArcOutputOrder::Toc;
+  // Evaluated during TOC pass, rejected entries are never read
+  ArcPathFilter pathFilter;
+};
+
 void RE_EXTERN
 EnumerateArchive(BinReaderRef_e rd, Platform platform, std::string_view title,
                  std::function<AppExtractContext *()> demandContext,
                  const std::set<uint32> &classFilter, bool filterIsBlackList = false);
+// AppExtractContext is always called from the calling thread
+void RE_EXTERN
+EnumerateArchive(BinReaderRef_e rd, Platform platform, std::string_view title,
+                 std::function<AppExtractContext *()> demandContext,
+                 const std::set<uint32> &classFilter, bool filterIsBlackList,
+                 const ArcEnumerateSettings &settings);
+
+struct ArcEntry {
+  // Lowercase, '/' separated, with extension
+  std::string path;
+  // As stored in TOC, without extension
+  std::string name;
+  uint32 typeHash;
+  uint32 compressedSize;
+  uint32 uncompressedSize;
+  uint32 offset;
+  bool isStored;
+};
+
+struct ArcVerifyIssue {
+  // Index into ArcReader::Entries()
+  size_t entry;
+  std::string message;
+};
+
+struct ArcVerifyReport {
+  size_t numEntries;
+  uint64 compressedBytes;
+  uint64 uncompressedBytes;
+  double seconds;
+  std::vector<ArcVerifyIssue> issues;
+
+  // Uncompressed MB/s
+  double Throughput() const {
+    return seconds > 0 ? uncompressedBytes / (seconds * 0x100000) : 0;
+  }
+};
+
+class ArcReaderImpl;
+
+// Parses archive TOC once and serves single entries by path.
+// Decompress and ReadRaw are thread safe, stream must outlive reader.
+class RE_EXTERN ArcReader {
+public:
+  ArcReader(BinReaderRef_e rd, Platform platform, std::string_view title);
+  // Memory mapped mode
+  ArcReader(const std::string &path, Platform platform,
+            std::string_view title);
+  ArcReader(ArcReader &&);
+  ~ArcReader();
+
+  Platform GetPlatform() const;
+  bool IsMapped() const;
+  std::span<const ArcEntry> Entries() const;
+  // Case insensitive, accepts both '/' and '\' separators
+  // Returns nullptr if not found
+  const ArcEntry *Find(std::string_view path) const;
+
+  void Decompress(const ArcEntry &entry, std::string &outBuffer) const;
+  std::string Decompress(const ArcEntry &entry) const;
+  // Throws if entry is not found
+  std::string Decompress(std::string_view path) const;
+  // In mapped mode, stored entries are returned as view into mapping,
+  // otherwise entry is decompressed into buffer and view into buffer is
+  // returned. View is valid for lifetime of reader or buffer.
+  std::string_view Get(const ArcEntry &entry, std::string &buffer) const;
+  // Decrypted, but still compressed entry data
+  std::string ReadRaw(const ArcEntry &entry) const;
+  // Decompresses every entry with numThreads workers (0 = all cores).
+  // Checks decoder errors, inflated sizes, out of bounds and overlapping
+  // entry data. Entries sharing identical data are not overlaps.
+  ArcVerifyReport Verify(uint32 numThreads = 0) const;
+
+private:
+  std::unique_ptr<ArcReaderImpl> pi;
+};
+
 size_t RE_EXTERN CompressZlib(std::string_view inBuffer, std::string &outBuffer, int windowSize, int level);
 } // namespace revil
@@ -0,0 +1,61 @@
+/*  Revil Format Library
+    Copyright(C) 2026 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "arc.hpp"
+#include "arc_vfs.hpp"
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace revil {
+struct ArcEntryCacheStats {
+  size_t hits;
+  size_t misses;
+  size_t evictions;
+  size_t usedBytes;
+  size_t numEntries;
+};
+
+class ArcEntryCacheImpl;
+
+// Thread safe LRU cache of decompressed archive entries.
+// Least recently used entries are evicted once memoryCap is exceeded.
+class RE_EXTERN ArcEntryCache {
+public:
+  using Buffer = std::shared_ptr<const std::string>;
+
+  explicit ArcEntryCache(size_t memoryCap = 0x10000000);
+  ArcEntryCache(ArcEntryCache &&);
+  ~ArcEntryCache();
+
+  // Returned buffer stays valid after eviction
+  // Entries larger than memoryCap are returned, but not cached
+  Buffer Get(const ArcReader &archive, const ArcEntry &entry);
+  // Returns nullptr if path is not found
+  Buffer Get(const ArcVFS &vfs, std::string_view path);
+
+  // Must be called before cached archive is destroyed
+  void Erase(const ArcReader &archive);
+  void Clear();
+  void MemoryCap(size_t newCap);
+  ArcEntryCacheStats Stats() const;
+
+private:
+  std::unique_ptr<ArcEntryCacheImpl> pi;
+};
+} // namespace revil
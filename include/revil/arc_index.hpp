@@ -0,0 +1,72 @@
+/*  Revil Format Library
+    Copyright(C) 2026 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "platform.hpp"
+#include "settings.hpp"
+#include "spike/util/supercore.hpp"
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace revil {
+struct ArcIndexEntry {
+  // MTHashV2 of normalized path (lowercase, '/' separated, with extension)
+  uint32 pathHash;
+  uint32 archive;
+  uint32 typeHash;
+  uint32 offset;
+  uint32 compressedSize;
+  uint32 uncompressedSize;
+  uint32 pathOffset;
+  uint32 pathSize;
+};
+
+class ArcIndexImpl;
+
+// Memory mapped index of TOCs of all archives in a game folder.
+// Entries are sorted by path hash, archives by their relative path.
+class RE_EXTERN ArcIndex {
+public:
+  explicit ArcIndex(const std::string &indexPath);
+  ArcIndex(ArcIndex &&);
+  ~ArcIndex();
+
+  // Scans gameFolder for archives and writes index into indexPath.
+  // If indexPath holds valid index for the same title and platform,
+  // TOCs of archives with unchanged size and modification time are reused.
+  // Index is written into indexPath + ".tmp" and renamed over indexPath.
+  // Returns number of archives, that had to be parsed.
+  static size_t Build(const std::string &indexPath,
+                      const std::string &gameFolder, Platform platform,
+                      std::string_view title);
+
+  // When multiple archives contain the path, entry of the archive that is
+  // last in path order is returned (usually patch)
+  // Returns nullptr if not found
+  const ArcIndexEntry *Find(std::string_view path) const;
+  std::span<const ArcIndexEntry> Entries() const;
+  std::string_view Path(const ArcIndexEntry &entry) const;
+  size_t NumArchives() const;
+  // Relative to gameFolder, '/' separated
+  std::string_view ArchivePath(uint32 archive) const;
+
+private:
+  std::unique_ptr<ArcIndexImpl> pi;
+};
+} // namespace revil
@@ -0,0 +1,66 @@
+/*  Revil Format Library
+    Copyright(C) 2026 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "arc.hpp"
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace revil {
+struct ArcVFSEntry {
+  const ArcReader *archive;
+  const ArcEntry *entry;
+};
+
+class ArcVFSImpl;
+
+// Merged view of multiple archives, entries of later mounts override
+// entries of earlier mounts with the same path. Duplicate paths within
+// one archive resolve to its first entry, as in ArcReader::Find.
+// Mount is not thread safe, lookups and reads are.
+class RE_EXTERN ArcVFS {
+public:
+  ArcVFS();
+  ArcVFS(ArcVFS &&);
+  ~ArcVFS();
+
+  // Archive is opened in memory mapped mode
+  // Returns mount index
+  size_t Mount(const std::string &path, Platform platform,
+               std::string_view title);
+  size_t Mount(std::unique_ptr<ArcReader> archive);
+  size_t NumMounts() const;
+  const ArcReader &Archive(size_t mountIndex) const;
+
+  // Case insensitive, accepts both '/' and '\' separators
+  // Returns nullptr if not found
+  const ArcVFSEntry *Find(std::string_view path) const;
+  // Visits winning entry of every path, in no particular order
+  void Enumerate(std::function<void(const ArcVFSEntry &)> callback) const;
+  size_t NumEntries() const;
+
+  // Returns false if not found
+  bool Read(std::string_view path, std::string &outBuffer) const;
+  // Throws if not found
+  std::string Read(std::string_view path) const;
+
+private:
+  std::unique_ptr<ArcVFSImpl> pi;
+};
+} // namespace revil
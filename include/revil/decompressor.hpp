@@ -0,0 +1,60 @@
+/*  Revil Format Library
+    Copyright(C) 2026 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "settings.hpp"
+#include "spike/util/supercore.hpp"
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace revil {
+enum class CompressionType : uint8 {
+  Stored,
+  Zlib,    // Deflate with zlib header
+  Deflate, // Raw deflate stream
+  XMemLZX, // XMemCompress LZX with block headers
+};
+
+class DecompressorImpl;
+
+// Keeps codec states and scratch buffers between calls.
+// Not thread safe, use one instance per thread or ThreadLocal().
+class RE_EXTERN Decompressor {
+public:
+  Decompressor();
+  Decompressor(Decompressor &&);
+  ~Decompressor();
+
+  // output is the whole usable buffer, uncompressedSize is the expected
+  // size of decompressed data (required for XMemLZX)
+  // Returns number of decompressed bytes
+  size_t Decompress(CompressionType type, std::string_view input,
+                    std::span<char> output, size_t uncompressedSize,
+                    uint32 windowBits = 17);
+
+  // Pooled scratch buffers, they never shrink
+  std::string &InputBuffer(size_t minSize);
+  std::string &OutputBuffer(size_t minSize);
+
+  static Decompressor &ThreadLocal();
+
+private:
+  std::unique_ptr<DecompressorImpl> pi;
+};
+} // namespace revil
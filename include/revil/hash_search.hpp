@@ -0,0 +1,55 @@
+/*  Revil Format Library
+    Copyright(C) 2026 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "settings.hpp"
+#include "spike/util/supercore.hpp"
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace revil {
+// Candidates are: prefix + [0, maxTokens] tokens + suffix
+// Empty prefixes or suffixes are treated as a single empty string
+struct HashSearchSettings {
+  std::vector<std::string> prefixes;
+  std::vector<std::string> tokens;
+  std::vector<std::string> suffixes;
+  uint32 maxTokens = 2;
+  // 0 = hardware concurrency
+  uint32 numThreads = 0;
+  bool searchV1 = true;
+  bool searchV2 = true;
+};
+
+struct HashSearchResult {
+  uint32 hash;
+  std::string name;
+  bool isV1;
+};
+
+// Called from worker threads as soon as candidate is found, serialized
+using HashSearchCallback = std::function<void(const HashSearchResult &)>;
+
+// Searches names for target MTHashV1/MTHashV2 hashes, compared without
+// highest bit. Returned results are sorted by hash and name.
+std::vector<HashSearchResult> RE_EXTERN
+SearchHashes(std::span<const uint32> targets,
+             const HashSearchSettings &settings,
+             HashSearchCallback callback = nullptr);
+} // namespace revil
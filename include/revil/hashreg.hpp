@@ -20,10 +20,30 @@
 #include "settings.hpp"
 #include "spike/util/supercore.hpp"
 #include <functional>
+#include <memory>
 #include <span>
+#include <string>
 #include <string_view>
 
 namespace revil {
+enum class RegistryMode {
+  // Loaded registry is searched before already loaded ones
+  Overlay,
+  // Loaded registry is the only one searched
+  Replace,
+};
+
+// Registry list is not synchronized, LoadRegistry and ResetRegistry
+// must not be called while other threads do registry lookups.
+
+// Memory maps registry file written by make_db (redb.bin)
+// Every offset in file is bound checked before registry is used
+void RE_EXTERN LoadRegistry(const std::string &path,
+                            RegistryMode mode = RegistryMode::Overlay);
+// Unloads all registry files, only built-in registry is used
+// Invalidates strings, spans and TitleSupport returned from unloaded files
+void RE_EXTERN ResetRegistry();
+
 using Platforms = std::vector<Platform>;
 Platforms RE_EXTERN GetPlatformSupport(std::string_view title);
 const TitleSupport RE_EXTERN *GetTitleSupport(std::string_view title,
@@ -36,10 +56,35 @@ std::string_view RE_EXTERN GetClassName(uint32 hash);
 std::vector<uint32> RE_EXTERN GetHash(std::string_view extension,
                                       std::string_view title,
                                       Platform platform = Platform::Win32);
+class TitleContextImpl;
+
+// Title and platform resolved once for repeated registry lookups
+// Support() and spans from GetHash point into registry data, they dangle
+// after LoadRegistry with RegistryMode::Replace or ResetRegistry unloads it
+class RE_EXTERN TitleContext {
+public:
+  // Empty title = only common registry is used
+  TitleContext(std::string_view title, Platform platform);
+  TitleContext(TitleContext &&);
+  ~TitleContext();
+
+  std::string_view GetExtension(uint32 hash) const;
+  // Span is valid for lifetime of context and registry it was found in
+  std::span<const uint32> GetHash(std::string_view extension) const;
+  // nullptr for empty title
+  const TitleSupport *Support() const;
+
+private:
+  std::unique_ptr<TitleContextImpl> pi;
+};
+
 using TitleCallback = std::function<void(std::string_view)>;
 void RE_EXTERN GetTitles(TitleCallback cb);
 
 uint32 RE_EXTERN MTHashV1(std::string_view text);
 uint32 RE_EXTERN MTHashV2(std::string_view text);
 uint32 RE_EXTERN MTHashV2(std::string_view text, uint32 prev);
+// Hashes min(texts.size(), outHashes.size()) texts, multiple at once
+void RE_EXTERN MTHashV2(std::span<const std::string_view> texts,
+                        std::span<uint32> outHashes);
 }; // namespace revil
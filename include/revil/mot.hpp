@@ -23,6 +23,7 @@
 #include <variant>
 #include <vector>
 #include <map>
+#include <span>
 
 namespace revil {
 
@@ -102,8 +103,15 @@ public:
   Create(const LMTConstructorProperties &props);
 };
 
+// Remembers last sampled key span of a track.
+// Sequential sampling with increasing time avoids key search.
+struct LMTTrackCursor {
+  size_t key = 0;
+};
+
 class LMTTrack : public uni::MotionTrack {
 public:
+  using uni::MotionTrack::GetValue;
   enum TrackType_e {
     TrackType_LocalRotation,
     TrackType_LocalPosition,
@@ -122,6 +130,12 @@ public:
   virtual size_t Stride() const = 0;
   virtual uint32 BoneType() const = 0;
   virtual std::string_view CompressionType() const = 0;
+  // Cursor must be used only with one track
+  virtual void GetValue(Vector4A16 &out, float time,
+                        LMTTrackCursor &cursor) const = 0;
+  // Samples min(out.size(), times.size()) times, sorted in ascending order
+  virtual void GetValues(std::span<Vector4A16> out,
+                         std::span<const float> times) const = 0;
 
   static RE_EXTERN std::unique_ptr<LMTTrack>
   Create(const LMTConstructorProperties &props);
@@ -18,7 +18,9 @@
 #pragma once
 #include "spike/io/bincore_fwd.hpp"
 #include "settings.hpp"
+#include "spike/uni/motion.hpp"
 #include <memory>
+#include <span>
 #include <string>
 
 namespace revil {
@@ -44,4 +46,12 @@ public:
 private:
   std::unique_ptr<REAssetImpl> i;
 };
+
+// All tracks of uni::Motion from REAsset
+class REMotionTrack : public uni::MotionTrack {
+public:
+  // Samples min(out.size(), times.size()) times, sorted in ascending order
+  virtual void GetValues(std::span<Vector4A16> out,
+                         std::span<const float> times) const = 0;
+};
 } // namespace revil
@@ -17,148 +17,159 @@
 
 #include "revil/arc.hpp"
 #include "arc.hpp"
+#include "blowfish.hpp"
 #include "hfs.hpp"
+#include "mapped_file.hpp"
+#include "revil/decompressor.hpp"
 #include "revil/hashreg.hpp"
-#include "spike/crypto/blowfish.h"
 #include "spike/io/fileinfo.hpp"
 #include "spike/master_printer.hpp"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <set>
+#include <spanstream>
+#include <thread>
+#include <unordered_map>
 
-#include "lzx.h"
-#include "mspack.h"
 #include "zlib.h"
 
-#pragma region XMemDecompress
-
-struct mspack_file {
-  uint8 *buffer;
-  uint32 bufferSize;
-  uint32 position;
-  uint32 rest;
-};
-
-// https://github.com/gildor2/UEViewer/blob/master/Unreal/UnCoreCompression.cpp#L90
-static int mspack_read(mspack_file *file, void *buffer, int bytes) {
-  if (!file->rest) {
-    // read block header
-    if (file->buffer[file->position] == 0xFF) {
-      // [0]   = FF
-      // [1,2] = uncompressed block size
-      // [3,4] = compressed block size
-      file->rest = (file->buffer[file->position + 3] << 8) |
-                   file->buffer[file->position + 4];
-      file->position += 5;
-    } else {
-      // [0,1] = compressed size
-      file->rest = (file->buffer[file->position + 0] << 8) |
-                   file->buffer[file->position + 1];
-      file->position += 2;
-    }
+auto ReadARCC(BinReaderRef_e rd, BlowfishBatchDecoder &enc) {
+  ARC hdr;
+  rd.Read(hdr);
+  rd.Skip(-4);
 
-    if (file->rest > file->bufferSize - file->position) {
-      file->rest = file->bufferSize - file->position;
-    }
+  if (hdr.id != ARCCID) {
+    throw es::InvalidHeaderError(hdr.id);
   }
 
-  if (bytes > file->rest) {
-    bytes = file->rest;
-  }
+  ARCFiles files;
+  rd.ReadContainer(files, hdr.numFiles);
 
-  if (bytes <= 0) {
-    return 0;
-  }
+  auto buffer = reinterpret_cast<char *>(files.data());
+  size_t bufferSize = sizeof(ARCFile) * hdr.numFiles;
 
-  memcpy(buffer, file->buffer + file->position, bytes);
-  file->position += bytes;
-  file->rest -= bytes;
+  enc.Decode(buffer, bufferSize);
 
-  return bytes;
+  return std::make_tuple(hdr, files);
 }
 
-static int mspack_write(mspack_file *file, void *buffer, int bytes) {
-  if (bytes <= 0) {
-    return 0;
+static void DecompressEntry(char *inBuffer, uint32 compressedSize,
+                            char *outBuffer, size_t outBufferSize,
+                            uint32 uncompressedSize, bool isLZX,
+                            uint32 wBits) {
+  revil::Decompressor::ThreadLocal().Decompress(
+      isLZX ? revil::CompressionType::XMemLZX : revil::CompressionType::Zlib,
+      {inBuffer, compressedSize}, {outBuffer, outBufferSize}, uncompressedSize,
+      wBits);
+}
+
+static std::string MakeFilePath(const char *fileName, uint32 typeHash,
+                                const revil::TitleContext &titleCtx) {
+  auto ext = titleCtx.GetExtension(typeHash);
+  std::string filePath = fileName;
+  std::transform(filePath.begin(), filePath.end(), filePath.begin(),
+                 [](char c) { return tolower(c); });
+  filePath.push_back('.');
+
+  if (ext.empty()) {
+    char buffer[0x10]{};
+    snprintf(buffer, sizeof(buffer), "%.8" PRIX32, typeHash);
+    filePath += buffer;
+  } else {
+    filePath.append(ext);
   }
 
-  memcpy(file->buffer + file->position, buffer, bytes);
-  file->position += bytes;
-  return bytes;
+  return filePath;
 }
 
-static mspack_system mspackSystem{
-    nullptr,                                                     // open
-    nullptr,                                                     // close
-    mspack_read,                                                 // read
-    mspack_write,                                                // write
-    nullptr,                                                     // seek
-    nullptr,                                                     // tell
-    nullptr,                                                     // message
-    [](mspack_system *, size_t bytes) { return malloc(bytes); }, // alloc
-    free,                                                        // free
-    [](void *src, void *dst, size_t bytes) { memcpy(dst, src, bytes); }, // copy
-};
+static bool IsPathSeparator(char c) { return c == '/' || c == '\\'; }
 
-static void DecompressLZX(char *inBuffer, uint32 compressedSize,
-                          char *outBuffer, uint32 uncompressedSize,
-                          uint32 wBits) {
-  mspack_file inStream{};
-  mspack_file outStream{};
-  inStream.buffer = reinterpret_cast<uint8 *>(inBuffer);
-  inStream.bufferSize = compressedSize;
-  outStream.buffer = reinterpret_cast<uint8 *>(outBuffer);
-  outStream.bufferSize = uncompressedSize;
+static bool GlobMatch(std::string_view pattern, std::string_view path) {
+  while (!pattern.empty()) {
+    if (pattern.front() == '*') {
+      const bool anyFolder = pattern.starts_with("**");
+      pattern.remove_prefix(anyFolder ? 2 : 1);
 
-  lzxd_stream *lzxd = lzxd_init(&mspackSystem, &inStream, &outStream, wBits, 0,
-                                1 << wBits, uncompressedSize, false);
+      for (size_t i = 0;; i++) {
+        if (GlobMatch(pattern, path.substr(i))) {
+          return true;
+        }
 
-  int retVal = lzxd_decompress(lzxd, uncompressedSize);
+        if (i >= path.size() || (!anyFolder && IsPathSeparator(path[i]))) {
+          return false;
+        }
+      }
+    }
+
+    if (path.empty()) {
+      return false;
+    }
+
+    const char p = pattern.front();
+    const char c = path.front();
 
-  if (retVal != MSPACK_ERR_OK) {
-    throw std::runtime_error("LZX decompression error " +
-                             std::to_string(retVal));
+    if (p == '?') {
+      if (IsPathSeparator(c)) {
+        return false;
+      }
+    } else if (IsPathSeparator(p) ? !IsPathSeparator(c)
+                                  : tolower(p) != tolower(c)) {
+      return false;
+    }
+
+    pattern.remove_prefix(1);
+    path.remove_prefix(1);
   }
 
-  lzxd_free(lzxd);
+  // Matched path is a folder of the tested path or the tested path
+  // without extension
+  return path.empty() || IsPathSeparator(path.front()) ||
+         (path.front() == '.' && path.find_first_of("/\\") == path.npos);
 }
 
-#pragma endregion
-
-auto ReadARCC(BinReaderRef_e rd, BlowfishEncoder &enc) {
-  ARC hdr;
-  rd.Read(hdr);
-  rd.Skip(-4);
+static bool GlobMatchAny(const std::vector<std::string> &patterns,
+                         std::string_view path) {
+  for (std::string_view pattern : patterns) {
+    while (!pattern.empty() && IsPathSeparator(pattern.back())) {
+      pattern.remove_suffix(1);
+    }
 
-  if (hdr.id != ARCCID) {
-    throw es::InvalidHeaderError(hdr.id);
+    if (GlobMatch(pattern, path)) {
+      return true;
+    }
   }
 
-  ARCFiles files;
-  rd.ReadContainer(files, hdr.numFiles);
-
-  auto buffer = reinterpret_cast<char *>(files.data());
-  size_t bufferSize = sizeof(ARCFile) * hdr.numFiles;
+  return false;
+}
 
-  enc.Decode(buffer, bufferSize);
+bool revil::ArcPathFilter::Accepts(std::string_view path) const {
+  if (!include.empty() && !GlobMatchAny(include, path)) {
+    return false;
+  }
 
-  return std::make_tuple(hdr, files);
+  return !GlobMatchAny(exclude, path);
 }
 
-void revil::EnumerateArchive(BinReaderRef_e rd, Platform platform,
-                             std::string_view title,
-                             std::function<AppExtractContext *()> demandContext,
-                             const std::set<uint32> &classFilter,
-                             bool filterIsBlackList) {
+// Unwraps HFS container and resolves Platform::Auto
+// Returns archive id
+static uint32 OpenArchive(BinReaderRef_e &rd, std::optional<HFSStream> &hfs,
+                          revil::Platform &platform) {
+  using revil::Platform;
   uint32 id;
   rd.Push();
   rd.Read(id);
   rd.Pop();
-  ARC hdr;
 
-  std::stringstream backup;
   if (id == SFHID) {
-    backup = ProcessHFS(rd);
-    rd = BinReaderRef_e(backup);
+    hfs.emplace(rd);
+    rd = BinReaderRef_e(*hfs);
     rd.Push();
     rd.Read(id);
     rd.Pop();
@@ -176,30 +187,139 @@ void revil::EnumerateArchive(BinReaderRef_e rd, Platform platform,
     platform = autoPlatform;
   }
 
-  BlowfishEncoder enc;
+  return id;
+}
 
-  auto WriteFiles = [&](auto &files) {
-    auto ectx = demandContext();
-    if (ectx->RequiresFolders()) {
-      for (auto &f : files) {
-        if (classFilter.size() > 0 &&
-            classFilter.contains(f.typeHash) == filterIsBlackList) {
-          continue;
+namespace {
+struct ArcJob {
+  size_t sequence;
+  std::string filePath;
+  uint32 compressedSize;
+  uint32 uncompressedSize;
+  bool isStored;
+  size_t cost;
+  std::string inBuffer;
+  std::string outBuffer;
+};
+
+// Entries are read by calling thread, decoded by workers and handed back to
+// calling thread for AppExtractContext
+struct ArcJobQueue {
+  std::mutex mutex;
+  std::condition_variable jobReady;
+  std::condition_variable jobDone;
+  std::deque<std::unique_ptr<ArcJob>> pending;
+  std::map<size_t, std::unique_ptr<ArcJob>> done;
+  std::exception_ptr error;
+  size_t inFlight = 0;
+  size_t numSent = 0;
+  bool stop = false;
+  std::vector<std::thread> workers;
+
+  template <class Fn> void Start(uint32 numThreads, Fn &&decode) {
+    for (uint32 t = 0; t < numThreads; t++) {
+      workers.emplace_back([this, decode] {
+        while (true) {
+          std::unique_ptr<ArcJob> job;
+
+          {
+            std::unique_lock<std::mutex> lg(mutex);
+            jobReady.wait(lg, [&] { return stop || !pending.empty(); });
+
+            if (pending.empty()) {
+              return;
+            }
+
+            job = std::move(pending.front());
+            pending.pop_front();
+          }
+
+          try {
+            decode(*job);
+          } catch (...) {
+            std::lock_guard<std::mutex> lg(mutex);
+
+            if (!error) {
+              error = std::current_exception();
+            }
+          }
+
+          {
+            std::lock_guard<std::mutex> lg(mutex);
+            const size_t sequence = job->sequence;
+            done.emplace(sequence, std::move(job));
+          }
+
+          jobDone.notify_all();
         }
+      });
+    }
+  }
 
-        AFileInfo inf(f.fileName);
-        std::string cFolder(inf.GetFolder());
-        std::transform(cFolder.begin(), cFolder.end(), cFolder.begin(),
-                       [](char c) { return tolower(c); });
-        ectx->AddFolderPath(cFolder);
-      }
+  ~ArcJobQueue() {
+    {
+      std::lock_guard<std::mutex> lg(mutex);
+      stop = true;
+      pending.clear();
+    }
 
-      ectx->GenerateFolders();
+    jobReady.notify_all();
+
+    for (auto &w : workers) {
+      w.join();
+    }
+  }
+};
+} // namespace
+
+void revil::EnumerateArchive(BinReaderRef_e rd, Platform platform,
+                             std::string_view title,
+                             std::function<AppExtractContext *()> demandContext,
+                             const std::set<uint32> &classFilter,
+                             bool filterIsBlackList) {
+  EnumerateArchive(rd, platform, title, demandContext, classFilter,
+                   filterIsBlackList, ArcEnumerateSettings{});
+}
+
+void revil::EnumerateArchive(BinReaderRef_e rd, Platform platform,
+                             std::string_view title,
+                             std::function<AppExtractContext *()> demandContext,
+                             const std::set<uint32> &classFilter,
+                             bool filterIsBlackList,
+                             const ArcEnumerateSettings &settings) {
+  std::optional<HFSStream> hfs;
+  const uint32 id = OpenArchive(rd, hfs, platform);
+  const revil::TitleContext titleCtx(title, platform);
+  ARC hdr;
+
+  BlowfishBatchDecoder enc;
+  const uint32 numThreads = settings.numThreads
+                                ? settings.numThreads
+                                : std::max(std::thread::hardware_concurrency(),
+                                           1U);
+
+  const bool hasPathFilter = !settings.pathFilter.include.empty() ||
+                             !settings.pathFilter.exclude.empty();
+
+  // Resolves filePath of entry once, it's reused for output
+  auto IsFiltered = [&](auto &f, std::string &filePath) {
+    if (classFilter.size() > 0 &&
+        classFilter.contains(f.typeHash) == filterIsBlackList) {
+      return true;
     }
 
-    std::string inBuffer;
-    std::string outBuffer;
-    [&inBuffer, &outBuffer, &files] {
+    filePath = MakeFilePath(f.fileName, f.typeHash, titleCtx);
+
+    return hasPathFilter && !settings.pathFilter.Accepts(filePath);
+  };
+
+  auto IsStored = [&](auto &f) {
+    return IsStoredEntry(hdr, platform, f.compressedSize, f.uncompressedSize);
+  };
+
+  auto WriteFilesSerial = [&](auto &files, AppExtractContext *ectx) {
+    auto &decomp = revil::Decompressor::ThreadLocal();
+    [&decomp, &files] {
       size_t maxSize = 0;
       size_t maxSizeUnc = 0;
 
@@ -217,23 +337,22 @@ void revil::EnumerateArchive(BinReaderRef_e rd, Platform platform,
         maxSizeUnc = 0x8000;
       }
 
-      inBuffer.resize(maxSize);
-      outBuffer.resize(maxSizeUnc);
+      decomp.InputBuffer(maxSize);
+      decomp.OutputBuffer(maxSizeUnc);
     }();
 
-    for (auto &f : files) {
-      if (!f.compressedSize) {
-        continue;
-      }
+    std::string &inBuffer = decomp.InputBuffer(0);
+    std::string &outBuffer = decomp.OutputBuffer(0);
+    std::string filePath;
 
-      if (classFilter.size() > 0 &&
-          classFilter.contains(f.typeHash) == filterIsBlackList) {
+    for (auto &f : files) {
+      if (!f.compressedSize || IsFiltered(f, filePath)) {
         continue;
       }
 
       rd.Seek(f.offset);
 
-      if (platform == Platform::PS3 && f.compressedSize == f.uncompressedSize) {
+      if (IsStored(f)) {
         rd.ReadBuffer(&outBuffer[0], f.compressedSize);
 
         if (id == ARCCID) {
@@ -246,44 +365,151 @@ void revil::EnumerateArchive(BinReaderRef_e rd, Platform platform,
           enc.Decode(&inBuffer[0], f.compressedSize);
         }
 
-        if (hdr.IsLZX()) {
-          DecompressLZX(&inBuffer[0], f.compressedSize, &outBuffer[0],
-                        f.uncompressedSize, id == ARCID ? 17 : 15);
-        } else {
-          z_stream infstream;
-          infstream.zalloc = Z_NULL;
-          infstream.zfree = Z_NULL;
-          infstream.opaque = Z_NULL;
-          infstream.avail_in = f.compressedSize;
-          infstream.next_in = reinterpret_cast<Bytef *>(&inBuffer[0]);
-          infstream.avail_out = outBuffer.size();
-          infstream.next_out = reinterpret_cast<Bytef *>(&outBuffer[0]);
-          inflateInit(&infstream);
-          int state = inflate(&infstream, Z_FINISH);
-          inflateEnd(&infstream);
-
-          if (state < 0) {
-            throw std::runtime_error(infstream.msg);
-          }
+        DecompressEntry(&inBuffer[0], f.compressedSize, &outBuffer[0],
+                        outBuffer.size(), f.uncompressedSize, hdr.IsLZX(),
+                        id == ARCID ? 17 : 15);
+      }
+
+      ectx->NewFile(filePath);
+      ectx->SendData({outBuffer.data(), f.uncompressedSize});
+    }
+  };
+
+  auto WriteFilesParallel = [&](auto &files, AppExtractContext *ectx) {
+    ArcJobQueue queue;
+    const bool isLZX = hdr.IsLZX();
+    const uint32 wBits = id == ARCID ? 17 : 15;
+    const bool isEncrypted = id == ARCCID;
+
+    queue.Start(numThreads, [&enc, isLZX, wBits, isEncrypted](ArcJob &job) {
+      if (job.isStored) {
+        if (isEncrypted) {
+          enc.Decode(&job.outBuffer[0], job.compressedSize);
+        }
+
+        return;
+      }
+
+      if (isEncrypted) {
+        enc.Decode(&job.inBuffer[0], job.compressedSize);
+      }
+
+      DecompressEntry(&job.inBuffer[0], job.compressedSize, &job.outBuffer[0],
+                      job.outBuffer.size(), job.uncompressedSize, isLZX,
+                      wBits);
+    });
+
+    // Send every finished job that can be sent in requested order
+    auto Flush = [&](std::unique_lock<std::mutex> &lg) {
+      while (true) {
+        if (queue.error) {
+          std::rethrow_exception(queue.error);
+        }
+
+        auto found = settings.order == ArcOutputOrder::Toc
+                         ? queue.done.find(queue.numSent)
+                         : queue.done.begin();
+
+        if (found == queue.done.end()) {
+          return;
+        }
+
+        std::unique_ptr<ArcJob> job = std::move(found->second);
+        queue.done.erase(found);
+        queue.numSent++;
+        lg.unlock();
+        ectx->NewFile(job->filePath);
+        ectx->SendData({job->outBuffer.data(), job->uncompressedSize});
+        const size_t cost = job->cost;
+        job.reset();
+        lg.lock();
+        queue.inFlight -= cost;
+      }
+    };
+
+    size_t sequence = 0;
+    std::string filePath;
+
+    for (auto &f : files) {
+      if (!f.compressedSize || IsFiltered(f, filePath)) {
+        continue;
+      }
+
+      auto job = std::make_unique<ArcJob>();
+      job->sequence = sequence++;
+      job->filePath = std::move(filePath);
+      job->compressedSize = f.compressedSize;
+      job->uncompressedSize = f.uncompressedSize;
+      job->isStored = IsStored(f);
+      const size_t outSize =
+          std::max(size_t(f.uncompressedSize), size_t(0x8000));
+      job->cost = (job->isStored ? 0 : f.compressedSize) + outSize;
+
+      {
+        std::unique_lock<std::mutex> lg(queue.mutex);
+        Flush(lg);
+
+        while (queue.inFlight > 0 &&
+               queue.inFlight + job->cost > settings.memoryBudget) {
+          queue.jobDone.wait(lg);
+          Flush(lg);
         }
       }
 
-      auto ext = revil::GetExtension(f.typeHash, title, platform);
-      std::string filePath = f.fileName;
-      std::transform(filePath.begin(), filePath.end(), filePath.begin(),
-                     [](char c) { return tolower(c); });
-      filePath.push_back('.');
+      job->outBuffer.resize(outSize);
+      rd.Seek(f.offset);
 
-      if (ext.empty()) {
-        char buffer[0x10]{};
-        snprintf(buffer, sizeof(buffer), "%.8" PRIX32, f.typeHash);
-        filePath += buffer;
+      if (job->isStored) {
+        rd.ReadBuffer(&job->outBuffer[0], f.compressedSize);
       } else {
-        filePath.append(ext);
+        job->inBuffer.resize(f.compressedSize);
+        rd.ReadBuffer(&job->inBuffer[0], f.compressedSize);
       }
 
-      ectx->NewFile(filePath);
-      ectx->SendData({outBuffer.data(), f.uncompressedSize});
+      {
+        std::lock_guard<std::mutex> lg(queue.mutex);
+        queue.inFlight += job->cost;
+        queue.pending.emplace_back(std::move(job));
+      }
+
+      queue.jobReady.notify_one();
+    }
+
+    std::unique_lock<std::mutex> lg(queue.mutex);
+
+    while (queue.numSent < sequence) {
+      Flush(lg);
+
+      if (queue.numSent < sequence) {
+        queue.jobDone.wait(lg);
+      }
+    }
+  };
+
+  auto WriteFiles = [&](auto &files) {
+    auto ectx = demandContext();
+    if (ectx->RequiresFolders()) {
+      std::string filePath;
+
+      for (auto &f : files) {
+        if (IsFiltered(f, filePath)) {
+          continue;
+        }
+
+        AFileInfo inf(f.fileName);
+        std::string cFolder(inf.GetFolder());
+        std::transform(cFolder.begin(), cFolder.end(), cFolder.begin(),
+                       [](char c) { return tolower(c); });
+        ectx->AddFolderPath(cFolder);
+      }
+
+      ectx->GenerateFolders();
+    }
+
+    if (numThreads > 1) {
+      WriteFilesParallel(files, ectx);
+    } else {
+      WriteFilesSerial(files, ectx);
     }
   };
 
@@ -311,6 +537,323 @@ void revil::EnumerateArchive(BinReaderRef_e rd, Platform platform,
   }
 }
 
+class revil::ArcReaderImpl {
+public:
+  std::unique_ptr<MappedFile> mapped;
+  std::unique_ptr<std::ispanstream> mappedStream;
+  std::optional<HFSStream> hfs;
+  BinReaderRef_e rd;
+  uint32 id;
+  Platform platform;
+  ARC hdr;
+  BlowfishBatchDecoder enc;
+  std::vector<ArcEntry> entries;
+  std::unordered_map<std::string_view, size_t> index;
+  std::mutex readMutex;
+  // End of TOC and size of archive data (after HFS unwrapping)
+  size_t dataBegin = 0;
+  size_t dataSize = 0;
+
+  ArcReaderImpl(BinReaderRef_e rd_, Platform platform_, std::string_view title)
+      : rd(rd_), platform(platform_) {
+    Load(title);
+  }
+
+  ArcReaderImpl(std::unique_ptr<MappedFile> mapped_, Platform platform_,
+                std::string_view title)
+      : mapped(std::move(mapped_)),
+        mappedStream(std::make_unique<std::ispanstream>(
+            std::span<const char>(mapped->Data(), mapped->Size()))),
+        rd(*mappedStream), platform(platform_) {
+    Load(title);
+  }
+
+  // Entry can be served directly from mapping
+  bool IsZeroCopy(const ArcEntry &entry) const {
+    // HFS payload is interleaved with chunk trailers
+    return mapped && entry.isStored && id != ARCCID && !hfs &&
+           size_t(entry.offset) + entry.compressedSize <= mapped->Size();
+  }
+
+  void Load(std::string_view title) {
+    id = OpenArchive(rd, hfs, platform);
+    const revil::TitleContext titleCtx(title, platform);
+
+    auto AddEntries = [&](auto &files) {
+      entries.reserve(files.size());
+
+      for (auto &f : files) {
+        entries.emplace_back(ArcEntry{
+            .path = NormalizeArcPath(
+                MakeFilePath(f.fileName, f.typeHash, titleCtx)),
+            .name = std::string(f.fileName,
+                                strnlen(f.fileName, sizeof(f.fileName))),
+            .typeHash = f.typeHash,
+            .compressedSize = f.compressedSize,
+            .uncompressedSize = f.uncompressedSize,
+            .offset = f.offset,
+            .isStored = IsStoredEntry(hdr, platform, f.compressedSize,
+                                      f.uncompressedSize),
+        });
+      }
+
+      // First entry wins on duplicate paths, same as extraction would
+      for (size_t i = 0; i < entries.size(); i++) {
+        index.emplace(entries[i].path, i);
+      }
+
+      dataBegin = rd.Tell();
+      dataSize = rd.GetSize();
+    };
+
+    auto ts = revil::GetTitleSupport(title, platform);
+
+    if (ts->arc.flags & revil::DbArc_ExtendedPath) {
+      ARCExtendedFiles files;
+      std::tie(hdr, files) = ReadExtendedARC(rd);
+      AddEntries(files);
+    } else {
+      ARCFiles files;
+      if (id == ARCCID) {
+        std::string_view key(ts->arc.key);
+
+        if (key.empty()) {
+          throw es::RuntimeError(
+              "Encrypted archives not supported for this title");
+        }
+        enc.SetKey(key);
+        std::tie(hdr, files) = ReadARCC(rd, enc);
+      } else {
+        std::tie(hdr, files) = ReadARC(rd);
+      }
+      AddEntries(files);
+    }
+  }
+
+  void ReadEntry(const ArcEntry &entry, char *outBuffer) {
+    {
+      std::lock_guard<std::mutex> lg(readMutex);
+      rd.Seek(entry.offset);
+      rd.ReadBuffer(outBuffer, entry.compressedSize);
+    }
+
+    if (id == ARCCID) {
+      enc.Decode(outBuffer, entry.compressedSize);
+    }
+  }
+};
+
+revil::ArcReader::ArcReader(BinReaderRef_e rd, Platform platform,
+                            std::string_view title)
+    : pi(std::make_unique<ArcReaderImpl>(rd, platform, title)) {}
+revil::ArcReader::ArcReader(const std::string &path, Platform platform,
+                            std::string_view title)
+    : pi(std::make_unique<ArcReaderImpl>(std::make_unique<MappedFile>(path),
+                                         platform, title)) {}
+revil::ArcReader::ArcReader(ArcReader &&) = default;
+revil::ArcReader::~ArcReader() = default;
+
+revil::Platform revil::ArcReader::GetPlatform() const { return pi->platform; }
+
+std::span<const revil::ArcEntry> revil::ArcReader::Entries() const {
+  return pi->entries;
+}
+
+const revil::ArcEntry *revil::ArcReader::Find(std::string_view path) const {
+  auto found = pi->index.find(NormalizeArcPath(path));
+
+  if (found == pi->index.end()) {
+    return nullptr;
+  }
+
+  return &pi->entries.at(found->second);
+}
+
+void revil::ArcReader::Decompress(const ArcEntry &entry,
+                                  std::string &outBuffer) const {
+  if (!entry.compressedSize) {
+    outBuffer.clear();
+    return;
+  }
+
+  if (entry.isStored) {
+    outBuffer.resize(entry.compressedSize);
+    pi->ReadEntry(entry, outBuffer.data());
+    return;
+  }
+
+  auto &decomp = Decompressor::ThreadLocal();
+  std::string &inBuffer = decomp.InputBuffer(entry.compressedSize);
+  pi->ReadEntry(entry, inBuffer.data());
+  outBuffer.resize(entry.uncompressedSize);
+  DecompressEntry(inBuffer.data(), entry.compressedSize, outBuffer.data(),
+                  outBuffer.size(), entry.uncompressedSize, pi->hdr.IsLZX(),
+                  pi->id == ARCID ? 17 : 15);
+}
+
+std::string_view revil::ArcReader::Get(const ArcEntry &entry,
+                                       std::string &buffer) const {
+  if (pi->IsZeroCopy(entry)) {
+    return pi->mapped->View().substr(entry.offset, entry.compressedSize);
+  }
+
+  Decompress(entry, buffer);
+  return buffer;
+}
+
+bool revil::ArcReader::IsMapped() const { return bool(pi->mapped); }
+
+std::string revil::ArcReader::Decompress(const ArcEntry &entry) const {
+  std::string retVal;
+  Decompress(entry, retVal);
+  return retVal;
+}
+
+std::string revil::ArcReader::Decompress(std::string_view path) const {
+  auto entry = Find(path);
+
+  if (!entry) {
+    throw es::RuntimeError("Archive entry not found: " + std::string(path));
+  }
+
+  return Decompress(*entry);
+}
+
+std::string revil::ArcReader::ReadRaw(const ArcEntry &entry) const {
+  std::string retVal;
+  retVal.resize(entry.compressedSize);
+  pi->ReadEntry(entry, retVal.data());
+  return retVal;
+}
+
+revil::ArcVerifyReport revil::ArcReader::Verify(uint32 numThreads) const {
+  using clock = std::chrono::steady_clock;
+  const auto startTime = clock::now();
+  ArcVerifyReport report{};
+  report.numEntries = pi->entries.size();
+  std::vector<bool> checkedEntries(pi->entries.size(), true);
+
+  // Layout checks, entries sorted by data offset
+  std::vector<size_t> order;
+  order.reserve(pi->entries.size());
+
+  for (size_t i = 0; i < pi->entries.size(); i++) {
+    auto &e = pi->entries[i];
+
+    if (!e.compressedSize) {
+      checkedEntries[i] = false;
+      continue;
+    }
+
+    if (e.offset < pi->dataBegin) {
+      report.issues.emplace_back(ArcVerifyIssue{i, "Data overlap TOC"});
+      checkedEntries[i] = false;
+    } else if (size_t(e.offset) + e.compressedSize > pi->dataSize) {
+      report.issues.emplace_back(ArcVerifyIssue{i, "Data out of bounds"});
+      checkedEntries[i] = false;
+    } else {
+      order.push_back(i);
+    }
+  }
+
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    auto &ea = pi->entries[a];
+    auto &eb = pi->entries[b];
+    return ea.offset == eb.offset ? ea.compressedSize < eb.compressedSize
+                                  : ea.offset < eb.offset;
+  });
+
+  for (size_t i = 1; i < order.size(); i++) {
+    auto &prev = pi->entries[order[i - 1]];
+    auto &cur = pi->entries[order[i]];
+    const bool isShared = prev.offset == cur.offset &&
+                          prev.compressedSize == cur.compressedSize;
+
+    if (!isShared && cur.offset < size_t(prev.offset) + prev.compressedSize) {
+      report.issues.emplace_back(ArcVerifyIssue{
+          order[i], "Data overlap entry " + std::to_string(order[i - 1])});
+    }
+  }
+
+  // Decode checks
+  std::atomic_size_t nextEntry{0};
+  std::atomic_uint64_t compressedBytes{0};
+  std::atomic_uint64_t uncompressedBytes{0};
+  std::mutex issuesMutex;
+  const bool isLZX = pi->hdr.IsLZX();
+  const uint32 wBits = pi->id == ARCID ? 17 : 15;
+
+  auto Worker = [&] {
+    auto &decomp = Decompressor::ThreadLocal();
+
+    while (true) {
+      const size_t i = nextEntry++;
+
+      if (i >= pi->entries.size()) {
+        return;
+      }
+
+      if (!checkedEntries[i]) {
+        continue;
+      }
+
+      auto &e = pi->entries[i];
+
+      try {
+        if (e.isStored) {
+          pi->ReadEntry(e, decomp.OutputBuffer(e.compressedSize).data());
+        } else {
+          std::string &inBuffer = decomp.InputBuffer(e.compressedSize);
+          std::string &outBuffer = decomp.OutputBuffer(e.uncompressedSize);
+          pi->ReadEntry(e, inBuffer.data());
+          const size_t outSize = decomp.Decompress(
+              isLZX ? CompressionType::XMemLZX : CompressionType::Zlib,
+              {inBuffer.data(), e.compressedSize},
+              {outBuffer.data(), e.uncompressedSize}, e.uncompressedSize,
+              wBits);
+
+          if (outSize != e.uncompressedSize) {
+            throw es::RuntimeError(
+                "Size mismatch, expected " +
+                std::to_string(e.uncompressedSize) + ", got " +
+                std::to_string(outSize));
+          }
+        }
+
+        compressedBytes += e.compressedSize;
+        uncompressedBytes += e.uncompressedSize;
+      } catch (const std::exception &ex) {
+        std::lock_guard<std::mutex> lg(issuesMutex);
+        report.issues.emplace_back(ArcVerifyIssue{i, ex.what()});
+      }
+    }
+  };
+
+  const uint32 numWorkers =
+      numThreads ? numThreads
+                 : std::max(std::thread::hardware_concurrency(), 1U);
+  std::vector<std::thread> workers;
+
+  for (uint32 t = 1; t < numWorkers; t++) {
+    workers.emplace_back(Worker);
+  }
+
+  Worker();
+
+  for (auto &w : workers) {
+    w.join();
+  }
+
+  std::sort(report.issues.begin(), report.issues.end(),
+            [](auto &a, auto &b) { return a.entry < b.entry; });
+  report.compressedBytes = compressedBytes;
+  report.uncompressedBytes = uncompressedBytes;
+  report.seconds =
+      std::chrono::duration<double>(clock::now() - startTime).count();
+
+  return report;
+}
+
 size_t revil::CompressZlib(std::string_view inBuffer, std::string &outBuffer,
                            int windowSize, int level) {
   z_stream infstream;
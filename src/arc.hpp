@@ -16,9 +16,12 @@
 */
 
 #pragma once
+#include "revil/platform.hpp"
 #include "spike/except.hpp"
 #include "spike/io/binreader_stream.hpp"
 #include "spike/type/bitfield.hpp"
+#include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -102,9 +105,28 @@ struct ARC : ARCBase {
   bool IsUncompressed() const { return version >= 0x10 && LZXTag == 1; }
 };
 
+// Entry is stored without compression, LZX archives compress every entry
+inline bool IsStoredEntry(const ARC &hdr, revil::Platform platform,
+                          uint32 compressedSize, uint32 uncompressedSize) {
+  return !hdr.IsLZX() &&
+         (platform == revil::Platform::PS3 || hdr.IsUncompressed()) &&
+         compressedSize == uncompressedSize;
+}
+
 using ARCFiles = std::vector<ARCFile>;
 using ARCExtendedFiles = std::vector<ARCExtendedFile>;
 
+// Lowercase with '/' separators, as used by ArcReader and ArcVFS indices
+inline std::string NormalizeArcPath(std::string_view path) {
+  std::string retVal(path);
+
+  for (char &c : retVal) {
+    c = c == '\\' ? '/' : tolower(c);
+  }
+
+  return retVal;
+}
+
 inline auto ReadARC(BinReaderRef_e rd) {
   ARC hdr;
   rd.Read(hdr);
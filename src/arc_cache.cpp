@@ -0,0 +1,170 @@
+/*  Revil Format Library
+    Copyright(C) 2026 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "revil/arc_cache.hpp"
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+using namespace revil;
+
+namespace {
+struct CacheKey {
+  const ArcReader *archive;
+  const ArcEntry *entry;
+
+  bool operator==(const CacheKey &) const = default;
+};
+
+struct CacheKeyHash {
+  size_t operator()(const CacheKey &key) const {
+    const size_t h0 = std::hash<const void *>{}(key.archive);
+    const size_t h1 = std::hash<const void *>{}(key.entry);
+    return h0 ^ (h1 + 0x9E3779B97F4A7C15 + (h0 << 6) + (h0 >> 2));
+  }
+};
+
+struct CacheNode {
+  CacheKey key;
+  ArcEntryCache::Buffer data;
+};
+} // namespace
+
+class revil::ArcEntryCacheImpl {
+public:
+  mutable std::mutex mutex;
+  // Most recently used at front
+  std::list<CacheNode> nodes;
+  std::unordered_map<CacheKey, std::list<CacheNode>::iterator, CacheKeyHash>
+      lookup;
+  size_t memoryCap;
+  ArcEntryCacheStats stats{};
+
+  // Caller must hold mutex
+  void Evict() {
+    while (stats.usedBytes > memoryCap && !nodes.empty()) {
+      auto &node = nodes.back();
+      stats.usedBytes -= node.data->size();
+      stats.evictions++;
+      lookup.erase(node.key);
+      nodes.pop_back();
+    }
+
+    stats.numEntries = nodes.size();
+  }
+
+  // Caller must hold mutex
+  void Remove(std::list<CacheNode>::iterator node) {
+    stats.usedBytes -= node->data->size();
+    lookup.erase(node->key);
+    nodes.erase(node);
+    stats.numEntries = nodes.size();
+  }
+};
+
+ArcEntryCache::ArcEntryCache(size_t memoryCap)
+    : pi(std::make_unique<ArcEntryCacheImpl>()) {
+  pi->memoryCap = memoryCap;
+}
+ArcEntryCache::ArcEntryCache(ArcEntryCache &&) = default;
+ArcEntryCache::~ArcEntryCache() = default;
+
+ArcEntryCache::Buffer ArcEntryCache::Get(const ArcReader &archive,
+                                         const ArcEntry &entry) {
+  const CacheKey key{&archive, &entry};
+
+  {
+    std::lock_guard<std::mutex> lg(pi->mutex);
+    auto found = pi->lookup.find(key);
+
+    if (found != pi->lookup.end()) {
+      pi->stats.hits++;
+      pi->nodes.splice(pi->nodes.begin(), pi->nodes, found->second);
+      return found->second->data;
+    }
+
+    pi->stats.misses++;
+  }
+
+  // Decompress without holding lock, other entries can be served meanwhile
+  auto data = std::make_shared<std::string>();
+  archive.Decompress(entry, *data);
+
+  std::lock_guard<std::mutex> lg(pi->mutex);
+  auto found = pi->lookup.find(key);
+
+  // Other thread was faster
+  if (found != pi->lookup.end()) {
+    pi->nodes.splice(pi->nodes.begin(), pi->nodes, found->second);
+    return found->second->data;
+  }
+
+  if (data->size() > pi->memoryCap) {
+    return data;
+  }
+
+  pi->nodes.push_front(CacheNode{key, data});
+  pi->lookup.emplace(key, pi->nodes.begin());
+  pi->stats.usedBytes += data->size();
+  pi->Evict();
+
+  return data;
+}
+
+ArcEntryCache::Buffer ArcEntryCache::Get(const ArcVFS &vfs,
+                                         std::string_view path) {
+  auto found = vfs.Find(path);
+
+  if (!found) {
+    return nullptr;
+  }
+
+  return Get(*found->archive, *found->entry);
+}
+
+void ArcEntryCache::Erase(const ArcReader &archive) {
+  std::lock_guard<std::mutex> lg(pi->mutex);
+
+  for (auto it = pi->nodes.begin(); it != pi->nodes.end();) {
+    auto next = std::next(it);
+
+    if (it->key.archive == &archive) {
+      pi->Remove(it);
+    }
+
+    it = next;
+  }
+}
+
+void ArcEntryCache::Clear() {
+  std::lock_guard<std::mutex> lg(pi->mutex);
+  pi->nodes.clear();
+  pi->lookup.clear();
+  pi->stats.usedBytes = 0;
+  pi->stats.numEntries = 0;
+}
+
+void ArcEntryCache::MemoryCap(size_t newCap) {
+  std::lock_guard<std::mutex> lg(pi->mutex);
+  pi->memoryCap = newCap;
+  pi->Evict();
+}
+
+ArcEntryCacheStats ArcEntryCache::Stats() const {
+  std::lock_guard<std::mutex> lg(pi->mutex);
+  return pi->stats;
+}
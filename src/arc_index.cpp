@@ -0,0 +1,319 @@
+/*  Revil Format Library
+    Copyright(C) 2026 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "revil/arc_index.hpp"
+#include "arc.hpp"
+#include "mapped_file.hpp"
+#include "revil/arc.hpp"
+#include "revil/hashreg.hpp"
+#include "spike/except.hpp"
+#include "spike/io/binwritter.hpp"
+#include "spike/master_printer.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <vector>
+
+using namespace revil;
+
+namespace {
+struct ArcIndexHeader {
+  static constexpr uint32 ID = CompileFourCC("RIDX");
+  static constexpr uint32 VERSION = 1;
+  uint32 id = ID;
+  uint32 version = VERSION;
+  uint32 titleHash;
+  uint32 platform;
+  uint32 numArchives;
+  uint32 numEntries;
+  uint64 stringsSize;
+};
+
+struct ArcIndexArchive {
+  uint64 fileSize;
+  int64 modTime;
+  uint32 pathOffset;
+  uint32 pathSize;
+  uint32 numEntries;
+  uint32 null = 0;
+};
+
+// Layout: header, archives, entries, strings
+static_assert(sizeof(ArcIndexHeader) == 32);
+static_assert(sizeof(ArcIndexArchive) == 32);
+static_assert(sizeof(ArcIndexEntry) == 32);
+} // namespace
+
+class revil::ArcIndexImpl {
+public:
+  MappedFile mapped;
+  const ArcIndexHeader *header;
+  std::span<const ArcIndexArchive> archives;
+  std::span<const ArcIndexEntry> entries;
+  std::string_view strings;
+
+  ArcIndexImpl(const std::string &indexPath) : mapped(indexPath) {
+    std::string_view data = mapped.View();
+
+    if (data.size() < sizeof(ArcIndexHeader)) {
+      throw es::RuntimeError("Index file is too small: " + indexPath);
+    }
+
+    header = reinterpret_cast<const ArcIndexHeader *>(data.data());
+
+    if (header->id != ArcIndexHeader::ID) {
+      throw es::InvalidHeaderError(header->id);
+    }
+
+    if (header->version != ArcIndexHeader::VERSION) {
+      throw es::InvalidVersionError(header->version);
+    }
+
+    const size_t archivesSize =
+        size_t(header->numArchives) * sizeof(ArcIndexArchive);
+    const size_t entriesSize =
+        size_t(header->numEntries) * sizeof(ArcIndexEntry);
+
+    if (data.size() != sizeof(ArcIndexHeader) + archivesSize + entriesSize +
+                           header->stringsSize) {
+      throw es::RuntimeError("Index file size mismatch: " + indexPath);
+    }
+
+    const char *cursor = data.data() + sizeof(ArcIndexHeader);
+    archives = {reinterpret_cast<const ArcIndexArchive *>(cursor),
+                header->numArchives};
+    cursor += archivesSize;
+    entries = {reinterpret_cast<const ArcIndexEntry *>(cursor),
+               header->numEntries};
+    cursor += entriesSize;
+    strings = {cursor, size_t(header->stringsSize)};
+  }
+
+  std::string_view String(uint32 offset, uint32 size) const {
+    return strings.substr(offset, size);
+  }
+};
+
+ArcIndex::ArcIndex(const std::string &indexPath)
+    : pi(std::make_unique<ArcIndexImpl>(indexPath)) {}
+ArcIndex::ArcIndex(ArcIndex &&) = default;
+ArcIndex::~ArcIndex() = default;
+
+const ArcIndexEntry *ArcIndex::Find(std::string_view path) const {
+  const std::string normPath = NormalizeArcPath(path);
+  const uint32 pathHash = MTHashV2(normPath);
+  auto found = std::lower_bound(
+      pi->entries.begin(), pi->entries.end(), pathHash,
+      [](const ArcIndexEntry &e, uint32 hash) { return e.pathHash < hash; });
+  const ArcIndexEntry *retVal = nullptr;
+
+  // Entries with same hash are sorted by archive, verify path of each
+  for (; found != pi->entries.end() && found->pathHash == pathHash; found++) {
+    if (Path(*found) == normPath) {
+      retVal = &*found;
+    }
+  }
+
+  return retVal;
+}
+
+std::span<const ArcIndexEntry> ArcIndex::Entries() const {
+  return pi->entries;
+}
+
+std::string_view ArcIndex::Path(const ArcIndexEntry &entry) const {
+  return pi->String(entry.pathOffset, entry.pathSize);
+}
+
+size_t ArcIndex::NumArchives() const { return pi->archives.size(); }
+
+std::string_view ArcIndex::ArchivePath(uint32 archive) const {
+  auto &arc = pi->archives[archive];
+  return pi->String(arc.pathOffset, arc.pathSize);
+}
+
+size_t ArcIndex::Build(const std::string &indexPath,
+                       const std::string &gameFolder, Platform platform,
+                       std::string_view title) {
+  namespace fs = std::filesystem;
+  std::unique_ptr<ArcIndex> oldIndex;
+  const uint32 titleHash = MTHashV2(title);
+
+  if (fs::exists(indexPath)) {
+    try {
+      oldIndex = std::make_unique<ArcIndex>(indexPath);
+      auto oldHdr = oldIndex->pi->header;
+
+      if (oldHdr->titleHash != titleHash ||
+          oldHdr->platform != uint32(platform)) {
+        oldIndex.reset();
+      }
+    } catch (const std::exception &e) {
+      printwarning("Rebuilding invalid index " << indexPath << ": "
+                                               << e.what());
+    }
+  }
+
+  // Old archive id by relative path and entries of each old archive
+  std::map<std::string_view, uint32> oldArchives;
+  std::vector<std::vector<const ArcIndexEntry *>> oldEntries;
+
+  if (oldIndex) {
+    oldEntries.resize(oldIndex->NumArchives());
+
+    for (uint32 a = 0; a < oldIndex->NumArchives(); a++) {
+      oldArchives.emplace(oldIndex->ArchivePath(a), a);
+    }
+
+    for (auto &e : oldIndex->Entries()) {
+      oldEntries.at(e.archive).push_back(&e);
+    }
+  }
+
+  struct ArchiveFile {
+    std::string relPath;
+    fs::path fullPath;
+    uint64 fileSize;
+    int64 modTime;
+  };
+
+  std::vector<ArchiveFile> archiveFiles;
+
+  for (auto &f : fs::recursive_directory_iterator(gameFolder)) {
+    if (!f.is_regular_file()) {
+      continue;
+    }
+
+    std::string ext = f.path().extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](char c) { return tolower(c); });
+
+    if (ext != ".arc") {
+      continue;
+    }
+
+    archiveFiles.emplace_back(ArchiveFile{
+        .relPath = fs::relative(f.path(), gameFolder).generic_string(),
+        .fullPath = f.path(),
+        .fileSize = f.file_size(),
+        .modTime = f.last_write_time().time_since_epoch().count(),
+    });
+  }
+
+  std::sort(archiveFiles.begin(), archiveFiles.end(),
+            [](auto &a, auto &b) { return a.relPath < b.relPath; });
+
+  std::string strings;
+  std::vector<ArcIndexArchive> archives;
+  std::vector<ArcIndexEntry> entries;
+  size_t numParsed = 0;
+
+  auto AddString = [&](std::string_view str) {
+    const uint32 offset = strings.size();
+    strings.append(str);
+    return offset;
+  };
+
+  for (auto &f : archiveFiles) {
+    const uint32 archiveId = archives.size();
+    ArcIndexArchive arc{
+        .fileSize = f.fileSize,
+        .modTime = f.modTime,
+        .pathOffset = AddString(f.relPath),
+        .pathSize = uint32(f.relPath.size()),
+        .numEntries = 0,
+    };
+
+    auto AddEntry = [&](ArcIndexEntry entry, std::string_view path) {
+      entry.archive = archiveId;
+      entry.pathOffset = AddString(path);
+      entry.pathSize = path.size();
+      entries.push_back(entry);
+      arc.numEntries++;
+    };
+
+    if (auto found = oldArchives.find(f.relPath); found != oldArchives.end()) {
+      auto &oldArc = oldIndex->pi->archives[found->second];
+
+      if (oldArc.fileSize == f.fileSize && oldArc.modTime == f.modTime) {
+        for (auto e : oldEntries.at(found->second)) {
+          AddEntry(*e, oldIndex->Path(*e));
+        }
+
+        archives.push_back(arc);
+        continue;
+      }
+    }
+
+    const size_t entriesBegin = entries.size();
+
+    try {
+      ArcReader reader(f.fullPath.string(), platform, title);
+      numParsed++;
+
+      for (auto &e : reader.Entries()) {
+        AddEntry(
+            ArcIndexEntry{
+                .pathHash = MTHashV2(e.path),
+                .typeHash = e.typeHash,
+                .offset = e.offset,
+                .compressedSize = e.compressedSize,
+                .uncompressedSize = e.uncompressedSize,
+            },
+            e.path);
+      }
+    } catch (const std::exception &e) {
+      // Not recorded, so it is parsed again on next build
+      printwarning("Skipped archive " << f.relPath << ": " << e.what());
+      entries.resize(entriesBegin);
+      continue;
+    }
+
+    archives.push_back(arc);
+  }
+
+  std::stable_sort(entries.begin(), entries.end(), [](auto &a, auto &b) {
+    return a.pathHash < b.pathHash;
+  });
+
+  ArcIndexHeader hdr{
+      .titleHash = titleHash,
+      .platform = uint32(platform),
+      .numArchives = uint32(archives.size()),
+      .numEntries = uint32(entries.size()),
+      .stringsSize = strings.size(),
+  };
+
+  // Interrupted run must not leave truncated index behind
+  const std::string tempPath = indexPath + ".tmp";
+
+  {
+    BinWritter wr(tempPath);
+    wr.Write(hdr);
+    wr.WriteBuffer(reinterpret_cast<const char *>(archives.data()),
+                   archives.size() * sizeof(ArcIndexArchive));
+    wr.WriteBuffer(reinterpret_cast<const char *>(entries.data()),
+                   entries.size() * sizeof(ArcIndexEntry));
+    wr.WriteBuffer(strings.data(), strings.size());
+  }
+
+  // Release mapping, indexPath is about to be replaced
+  oldIndex.reset();
+  fs::rename(tempPath, indexPath);
+
+  return numParsed;
+}
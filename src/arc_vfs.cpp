@@ -0,0 +1,102 @@
+/*  Revil Format Library
+    Copyright(C) 2026 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "revil/arc_vfs.hpp"
+#include "arc.hpp"
+#include <unordered_map>
+#include <vector>
+
+using namespace revil;
+
+class revil::ArcVFSImpl {
+public:
+  std::vector<std::unique_ptr<ArcReader>> archives;
+  // Keys are owned by ArcEntry::path of mounted archives
+  std::unordered_map<std::string_view, ArcVFSEntry> index;
+};
+
+ArcVFS::ArcVFS() : pi(std::make_unique<ArcVFSImpl>()) {}
+ArcVFS::ArcVFS(ArcVFS &&) = default;
+ArcVFS::~ArcVFS() = default;
+
+size_t ArcVFS::Mount(const std::string &path, Platform platform,
+                     std::string_view title) {
+  return Mount(std::make_unique<ArcReader>(path, platform, title));
+}
+
+size_t ArcVFS::Mount(std::unique_ptr<ArcReader> archive) {
+  const ArcReader *reader = archive.get();
+  pi->archives.emplace_back(std::move(archive));
+
+  for (auto &e : reader->Entries()) {
+    // Within archive first entry wins, same as ArcReader::Find
+    if (reader->Find(e.path) != &e) {
+      continue;
+    }
+
+    pi->index.insert_or_assign(std::string_view(e.path),
+                               ArcVFSEntry{reader, &e});
+  }
+
+  return pi->archives.size() - 1;
+}
+
+size_t ArcVFS::NumMounts() const { return pi->archives.size(); }
+
+const ArcReader &ArcVFS::Archive(size_t mountIndex) const {
+  return *pi->archives.at(mountIndex);
+}
+
+const ArcVFSEntry *ArcVFS::Find(std::string_view path) const {
+  auto found = pi->index.find(NormalizeArcPath(path));
+
+  if (found == pi->index.end()) {
+    return nullptr;
+  }
+
+  return &found->second;
+}
+
+void ArcVFS::Enumerate(
+    std::function<void(const ArcVFSEntry &)> callback) const {
+  for (auto &[_, entry] : pi->index) {
+    callback(entry);
+  }
+}
+
+size_t ArcVFS::NumEntries() const { return pi->index.size(); }
+
+bool ArcVFS::Read(std::string_view path, std::string &outBuffer) const {
+  auto found = Find(path);
+
+  if (!found) {
+    return false;
+  }
+
+  found->archive->Decompress(*found->entry, outBuffer);
+  return true;
+}
+
+std::string ArcVFS::Read(std::string_view path) const {
+  std::string retVal;
+
+  if (!Read(path, retVal)) {
+    throw es::RuntimeError("VFS entry not found: " + std::string(path));
+  }
+
+  return retVal;
+}
@@ -0,0 +1,51 @@
+/*  Revil Format Library
+    Copyright(C) 2026 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+#include "spike/crypto/blowfish.h"
+#include "spike/util/supercore.hpp"
+#include <mutex>
+#include <string_view>
+
+// Blowfish ECB decoder, that interleaves 4 independent blocks per
+// iteration. Key schedule and word order are verified against BlowfishEncoder
+// on SetKey, BlowfishEncoder is used as fallback when neither order matches
+// and for partial blocks.
+// Decode is thread safe, fallback calls are serialized.
+class BlowfishBatchDecoder {
+public:
+  void SetKey(std::string_view key);
+  void Decode(char *data, size_t size) const;
+
+private:
+  enum class Mode : uint8 {
+    LittleEndian,
+    BigEndian,
+    Reference,
+  };
+
+  uint32 P[18];
+  uint32 S[4][256];
+  Mode mode = Mode::Reference;
+  mutable BlowfishEncoder reference;
+  mutable std::mutex referenceMutex;
+
+  void Expand(std::string_view key);
+  void EncryptBlock(uint32 &left, uint32 &right) const;
+  void DecodeReference(char *data, size_t size) const;
+  template <bool bigEndian> void DecodeBlocks(char *data, size_t size) const;
+};
@@ -0,0 +1,274 @@
+/*  Revil Format Library
+    Copyright(C) 2026 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "revil/decompressor.hpp"
+#include "spike/except.hpp"
+#include <algorithm>
+
+#include "lzx.h"
+#include "mspack.h"
+#include "zlib.h"
+
+#pragma region XMemDecompress
+
+struct mspack_file {
+  uint8 *buffer;
+  uint32 bufferSize;
+  uint32 position;
+  uint32 rest;
+};
+
+// https://github.com/gildor2/UEViewer/blob/master/Unreal/UnCoreCompression.cpp#L90
+static int mspack_read(mspack_file *file, void *buffer, int bytes) {
+  if (!file->rest) {
+    // read block header
+    if (file->buffer[file->position] == 0xFF) {
+      // [0]   = FF
+      // [1,2] = uncompressed block size
+      // [3,4] = compressed block size
+      file->rest = (file->buffer[file->position + 3] << 8) |
+                   file->buffer[file->position + 4];
+      file->position += 5;
+    } else {
+      // [0,1] = compressed size
+      file->rest = (file->buffer[file->position + 0] << 8) |
+                   file->buffer[file->position + 1];
+      file->position += 2;
+    }
+
+    if (file->rest > file->bufferSize - file->position) {
+      file->rest = file->bufferSize - file->position;
+    }
+  }
+
+  if (bytes > file->rest) {
+    bytes = file->rest;
+  }
+
+  if (bytes <= 0) {
+    return 0;
+  }
+
+  memcpy(buffer, file->buffer + file->position, bytes);
+  file->position += bytes;
+  file->rest -= bytes;
+
+  return bytes;
+}
+
+static int mspack_write(mspack_file *file, void *buffer, int bytes) {
+  if (bytes <= 0) {
+    return 0;
+  }
+
+  memcpy(file->buffer + file->position, buffer, bytes);
+  file->position += bytes;
+  return bytes;
+}
+
+static mspack_system mspackSystem{
+    nullptr,                                                     // open
+    nullptr,                                                     // close
+    mspack_read,                                                 // read
+    mspack_write,                                                // write
+    nullptr,                                                     // seek
+    nullptr,                                                     // tell
+    nullptr,                                                     // message
+    [](mspack_system *, size_t bytes) { return malloc(bytes); }, // alloc
+    free,                                                        // free
+    [](void *src, void *dst, size_t bytes) { memcpy(dst, src, bytes); }, // copy
+};
+
+// Same as lzxd_init does, but keeps allocated window and input buffer
+static void RearmLZX(lzxd_stream *lzx, off_t outputLength) {
+  lzx->offset = 0;
+  lzx->length = outputLength;
+  lzx->ref_data_size = 0;
+  lzx->window_posn = 0;
+  lzx->frame_posn = 0;
+  lzx->frame = 0;
+  lzx->intel_filesize = 0;
+  lzx->intel_curpos = 0;
+  lzx->intel_started = 0;
+  lzx->error = MSPACK_ERR_OK;
+  lzx->o_ptr = lzx->o_end = &lzx->e8_buf[0];
+
+  lzx->R0 = 1;
+  lzx->R1 = 1;
+  lzx->R2 = 1;
+  lzx->header_read = 0;
+  lzx->block_remaining = 0;
+  lzx->block_type = LZX_BLOCKTYPE_INVALID;
+  std::fill(std::begin(lzx->MAINTREE_len),
+            std::begin(lzx->MAINTREE_len) + LZX_MAINTREE_MAXSYMBOLS, 0);
+  std::fill(std::begin(lzx->LENGTH_len),
+            std::begin(lzx->LENGTH_len) + LZX_LENGTH_MAXSYMBOLS, 0);
+
+  lzx->i_ptr = lzx->i_end = &lzx->inbuf[0];
+  lzx->bit_buffer = 0;
+  lzx->bits_left = 0;
+  lzx->input_end = 0;
+}
+
+#pragma endregion
+
+namespace revil {
+class DecompressorImpl {
+public:
+  static constexpr uint32 LZX_MIN_WINDOW = 15;
+  static constexpr uint32 LZX_MAX_WINDOW = 21;
+
+  z_stream zStream{};
+  bool zStreamReady = false;
+  mspack_file lzxInput{};
+  mspack_file lzxOutput{};
+  lzxd_stream *lzxStreams[LZX_MAX_WINDOW - LZX_MIN_WINDOW + 1]{};
+  std::string inBuffer;
+  std::string outBuffer;
+
+  ~DecompressorImpl() {
+    if (zStreamReady) {
+      inflateEnd(&zStream);
+    }
+
+    for (auto s : lzxStreams) {
+      if (s) {
+        lzxd_free(s);
+      }
+    }
+  }
+
+  size_t Inflate(std::string_view input, std::span<char> output, bool raw) {
+    const int windowBits = raw ? -MAX_WBITS : MAX_WBITS;
+
+    if (!zStreamReady) {
+      if (inflateInit2(&zStream, windowBits) != Z_OK) {
+        throw es::RuntimeError("Cannot initialize inflate stream");
+      }
+
+      zStreamReady = true;
+    } else {
+      inflateReset2(&zStream, windowBits);
+    }
+
+    zStream.avail_in = input.size();
+    zStream.next_in =
+        const_cast<Bytef *>(reinterpret_cast<const Bytef *>(input.data()));
+    zStream.avail_out = output.size();
+    zStream.next_out = reinterpret_cast<Bytef *>(output.data());
+    int state = inflate(&zStream, Z_FINISH);
+
+    if (state < 0) {
+      throw std::runtime_error(zStream.msg ? zStream.msg
+                                           : "Inflate error " +
+                                                 std::to_string(state));
+    }
+
+    return zStream.total_out;
+  }
+
+  size_t DecompressLZX(std::string_view input, std::span<char> output,
+                       size_t uncompressedSize, uint32 wBits) {
+    if (wBits < LZX_MIN_WINDOW || wBits > LZX_MAX_WINDOW) {
+      throw es::RuntimeError("Invalid LZX window size " +
+                             std::to_string(wBits));
+    }
+
+    if (uncompressedSize > output.size()) {
+      throw es::RuntimeError("LZX output buffer is too small");
+    }
+
+    lzxInput = {};
+    lzxInput.buffer =
+        const_cast<uint8 *>(reinterpret_cast<const uint8 *>(input.data()));
+    lzxInput.bufferSize = input.size();
+    lzxOutput = {};
+    lzxOutput.buffer = reinterpret_cast<uint8 *>(output.data());
+    lzxOutput.bufferSize = uncompressedSize;
+
+    lzxd_stream *&lzxd = lzxStreams[wBits - LZX_MIN_WINDOW];
+
+    if (!lzxd) {
+      lzxd = lzxd_init(&mspackSystem, &lzxInput, &lzxOutput, wBits, 0,
+                       1 << wBits, uncompressedSize, false);
+
+      if (!lzxd) {
+        throw es::RuntimeError("Cannot initialize LZX stream");
+      }
+    } else {
+      RearmLZX(lzxd, uncompressedSize);
+    }
+
+    int retVal = lzxd_decompress(lzxd, uncompressedSize);
+
+    if (retVal != MSPACK_ERR_OK) {
+      // State might be inconsistent, start over next time
+      lzxd_free(lzxd);
+      lzxd = nullptr;
+      throw std::runtime_error("LZX decompression error " +
+                               std::to_string(retVal));
+    }
+
+    return uncompressedSize;
+  }
+};
+
+Decompressor::Decompressor() : pi(std::make_unique<DecompressorImpl>()) {}
+Decompressor::Decompressor(Decompressor &&) = default;
+Decompressor::~Decompressor() = default;
+
+size_t Decompressor::Decompress(CompressionType type, std::string_view input,
+                                std::span<char> output,
+                                size_t uncompressedSize, uint32 windowBits) {
+  switch (type) {
+  case CompressionType::Stored: {
+    const size_t copySize = std::min(input.size(), output.size());
+    memcpy(output.data(), input.data(), copySize);
+    return copySize;
+  }
+  case CompressionType::Zlib:
+    return pi->Inflate(input, output, false);
+  case CompressionType::Deflate:
+    return pi->Inflate(input, output, true);
+  case CompressionType::XMemLZX:
+    return pi->DecompressLZX(input, output, uncompressedSize, windowBits);
+  }
+
+  throw es::RuntimeError("Unknown compression type");
+}
+
+std::string &Decompressor::InputBuffer(size_t minSize) {
+  if (pi->inBuffer.size() < minSize) {
+    pi->inBuffer.resize(minSize);
+  }
+
+  return pi->inBuffer;
+}
+
+std::string &Decompressor::OutputBuffer(size_t minSize) {
+  if (pi->outBuffer.size() < minSize) {
+    pi->outBuffer.resize(minSize);
+  }
+
+  return pi->outBuffer;
+}
+
+Decompressor &Decompressor::ThreadLocal() {
+  static thread_local Decompressor instance;
+  return instance;
+}
+} // namespace revil
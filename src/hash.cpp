@@ -1,31 +1,53 @@
 #include "revil/hashreg.hpp"
+#include <algorithm>
 #include <cstring>
 
+namespace {
+// LCG used for seeding: x' = 0x10DCD * x + 1
+constexpr uint32 MT_LCG_MUL = 0x10DCD;
+
+struct LCGJump {
+  uint32 mul = 1;
+  uint32 add = 0;
+};
+
+// Coefficients of LCG applied numSteps times: x' = mul * x + add
+constexpr LCGJump MakeLCGJump(size_t numSteps) {
+  LCGJump retVal;
+
+  for (size_t i = 0; i < numSteps; i++) {
+    retVal.mul *= MT_LCG_MUL;
+    retVal.add = retVal.add * MT_LCG_MUL + 1;
+  }
+
+  return retVal;
+}
+
+// mtData[i] is built from LCG states 2i and 2i + 1
+constexpr LCGJump LCG_JUMP_397 = MakeLCGJump(397 * 2);
+
+constexpr uint32 LCGNext(uint32 seed) { return MT_LCG_MUL * seed + 1; }
+
+constexpr uint32 MTWord(uint32 seed) {
+  return (seed & 0xFFFF0000) | (LCGNext(seed) >> 16);
+}
+} // namespace
+
 // Basically butchered Mersenne Twister
+// Only mtData[0], mtData[1] and mtData[397] of seeded state are used,
+// those are computed directly instead of generating whole state
 uint32 revil::MTHashV1(std::string_view text) {
   uint32 retVal = 0;
-  uint32 mtData[624];
-
-  auto makeSeed = [&](uint32 seed) {
-    mtData[0] = seed & 0xFFFF0000;
-    seed = 0x10DCD * seed + 1;
-    mtData[0] |= seed >> 16;
-
-    for (size_t i = 1; i < 624; i++) {
-      seed = 0x10DCD * seed + 1;
-      mtData[i] = seed & 0xFFFF0000;
-      seed = 0x10DCD * seed + 1;
-      mtData[i] |= seed >> 16;
-    }
-  };
-
-  makeSeed(2004);
 
   for (size_t i = 0; i < text.size(); i++) {
     auto nextChar = i + 1 == text.size() ? 0 : text[i + 1];
-    makeSeed((nextChar - 32) | ((text[i] - 32) << 6));
-    uint32 tmp0 = mtData[0] ^ ((mtData[0] ^ mtData[1]) & 0x7FFFFFFF);
-    uint32 tmp1 = mtData[397] ^ (0x9908B0DF * (tmp0 & 1)) ^ (tmp0 >> 1);
+    const uint32 seed = (nextChar - 32) | ((text[i] - 32) << 6);
+    const uint32 mtData0 = MTWord(seed);
+    const uint32 mtData1 = MTWord(LCGNext(LCGNext(seed)));
+    const uint32 mtData397 =
+        MTWord(LCG_JUMP_397.mul * seed + LCG_JUMP_397.add);
+    uint32 tmp0 = mtData0 ^ ((mtData0 ^ mtData1) & 0x7FFFFFFF);
+    uint32 tmp1 = mtData397 ^ (0x9908B0DF * (tmp0 & 1)) ^ (tmp0 >> 1);
     tmp1 ^= tmp1 >> 11;
 
     retVal ^= (((((tmp1 & 0xFF3A58AD) << 7) ^ tmp1) & 0xFFFFDF8C) << 15) ^
@@ -401,7 +423,7 @@ static const uint32 crc32bBoxes[][0x100] = {
     },
 };
 
-uint32 revil::MTHashV2(std::string_view data, uint32 prev) {
+static uint32 CRC32Table(std::string_view data, uint32 prev) {
   const size_t numChunks = data.size() / 8;
   const size_t numRest = data.size() % 8;
   union Chunk {
@@ -433,7 +455,152 @@ uint32 revil::MTHashV2(std::string_view data, uint32 prev) {
   return prev;
 }
 
+#if defined(__x86_64__) || defined(_M_X64)
+#define RE_CRC32_PCLMUL
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define RE_TARGET_PCLMUL
+#else
+#include <cpuid.h>
+#define RE_TARGET_PCLMUL __attribute__((target("pclmul,sse4.1")))
+#endif
+#include <immintrin.h>
+
+static bool HasPCLMUL() {
+  uint32 regs[4]{};
+#ifdef _MSC_VER
+  __cpuid(reinterpret_cast<int *>(regs), 1);
+#else
+  __get_cpuid(1, &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif
+  // ecx: PCLMULQDQ, SSE4.1
+  return (regs[2] & (1 << 1)) && (regs[2] & (1 << 19));
+}
+
+RE_TARGET_PCLMUL static inline __m128i CRC32Load(const char *ptr) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+}
+
+RE_TARGET_PCLMUL static inline __m128i CRC32Fold(__m128i x, __m128i k,
+                                                 __m128i next) {
+  const __m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+  const __m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+  return _mm_xor_si128(_mm_xor_si128(lo, hi), next);
+}
+
+// Folding of reflected CRC32 with carry-less multiply
+// Intel: Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+// size must be multiple of 16 and at least 64
+RE_TARGET_PCLMUL static uint32 CRC32PCLMUL(const char *data, size_t size,
+                                           uint32 prev) {
+  // x^(4*128+32) mod P, x^(4*128-32) mod P
+  const __m128i k1k2 = _mm_set_epi64x(0x1c6e41596, 0x154442bd4);
+  // x^(128+32) mod P, x^(128-32) mod P
+  const __m128i k3k4 = _mm_set_epi64x(0x0ccaa009e, 0x1751997d0);
+  // x^64 mod P
+  const __m128i k5 = _mm_set_epi64x(0, 0x163cd6124);
+  // Barrett reduction: floor(x^64 / P), P
+  const __m128i uPoly = _mm_set_epi64x(0x1f7011641, 0x1db710641);
+  const __m128i mask32 = _mm_set_epi32(0, 0, 0, -1);
+
+  __m128i x0 = _mm_xor_si128(CRC32Load(data), _mm_cvtsi32_si128(prev));
+  __m128i x1 = CRC32Load(data + 16);
+  __m128i x2 = CRC32Load(data + 32);
+  __m128i x3 = CRC32Load(data + 48);
+  data += 64;
+  size -= 64;
+
+  for (; size >= 64; size -= 64, data += 64) {
+    x0 = CRC32Fold(x0, k1k2, CRC32Load(data));
+    x1 = CRC32Fold(x1, k1k2, CRC32Load(data + 16));
+    x2 = CRC32Fold(x2, k1k2, CRC32Load(data + 32));
+    x3 = CRC32Fold(x3, k1k2, CRC32Load(data + 48));
+  }
+
+  x0 = CRC32Fold(x0, k3k4, x1);
+  x0 = CRC32Fold(x0, k3k4, x2);
+  x0 = CRC32Fold(x0, k3k4, x3);
+
+  for (; size >= 16; size -= 16, data += 16) {
+    x0 = CRC32Fold(x0, k3k4, CRC32Load(data));
+  }
+
+  // 128 -> 64 bits
+  x0 = _mm_xor_si128(_mm_srli_si128(x0, 8),
+                     _mm_clmulepi64_si128(x0, k3k4, 0x10));
+  // 64 -> 32 bits
+  x0 = _mm_xor_si128(_mm_srli_si128(x0, 4),
+                     _mm_clmulepi64_si128(_mm_and_si128(x0, mask32), k5, 0x00));
+  // Barrett reduction
+  __m128i t = _mm_clmulepi64_si128(_mm_and_si128(x0, mask32), uPoly, 0x10);
+  t = _mm_clmulepi64_si128(_mm_and_si128(t, mask32), uPoly, 0x00);
+
+  return _mm_extract_epi32(_mm_xor_si128(x0, t), 1);
+}
+
+// Below this size table is faster than setting up folding
+static constexpr size_t PCLMUL_MIN_SIZE = 64;
+#endif
+
+uint32 revil::MTHashV2(std::string_view data, uint32 prev) {
+#ifdef RE_CRC32_PCLMUL
+  static const bool hasPCLMUL = HasPCLMUL();
+
+  if (hasPCLMUL && data.size() >= PCLMUL_MIN_SIZE) {
+    const size_t foldSize = data.size() & ~size_t(15);
+    prev = CRC32PCLMUL(data.data(), foldSize, prev);
+    data.remove_prefix(foldSize);
+  }
+#endif
+
+  return CRC32Table(data, prev);
+}
+
 // Basically CRC32B with small adjustments
 uint32 revil::MTHashV2(std::string_view data) {
   return MTHashV2(data, 0xFFFFFFFF) & 0x7FFFFFFF;
 }
+
+void revil::MTHashV2(std::span<const std::string_view> texts,
+                     std::span<uint32> outHashes) {
+  static constexpr size_t NUM_LANES = 4;
+  const size_t numTexts = std::min(texts.size(), outHashes.size());
+  size_t t = 0;
+
+  // Independent table lookups of multiple strings are interleaved
+  for (; t + NUM_LANES <= numTexts; t += NUM_LANES) {
+    uint32 crc[NUM_LANES];
+    size_t numChunks = SIZE_MAX;
+
+    for (size_t l = 0; l < NUM_LANES; l++) {
+      crc[l] = 0xFFFFFFFF;
+      numChunks = std::min(numChunks, texts[t + l].size() / 8);
+    }
+
+    for (size_t i = 0; i < numChunks; i++) {
+      uint64 chunks[NUM_LANES];
+
+      for (size_t l = 0; l < NUM_LANES; l++) {
+        memcpy(&chunks[l], texts[t + l].data() + i * 8, 8);
+        chunks[l] ^= crc[l];
+        crc[l] = 0;
+      }
+
+      for (size_t n = 0; n < 8; n++) {
+        for (size_t l = 0; l < NUM_LANES; l++) {
+          crc[l] ^= crc32bBoxes[7 - n][(chunks[l] >> (n * 8)) & 0xFF];
+        }
+      }
+    }
+
+    for (size_t l = 0; l < NUM_LANES; l++) {
+      outHashes[t + l] =
+          MTHashV2(texts[t + l].substr(numChunks * 8), crc[l]) & 0x7FFFFFFF;
+    }
+  }
+
+  for (; t < numTexts; t++) {
+    outHashes[t] = MTHashV2(texts[t]);
+  }
+}
@@ -0,0 +1,238 @@
+/*  Revil Format Library
+    Copyright(C) 2026 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "revil/hash_search.hpp"
+#include "revil/hashreg.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace revil;
+
+namespace {
+// MTHashV1 is xor of per character terms, every term depends only on
+// character and its successor (0 for last character)
+struct MTHashV1Terms {
+  uint32 terms[0x100][0x100];
+
+  MTHashV1Terms() {
+    for (size_t c = 0; c < 0x100; c++) {
+      const char text[]{char(c)};
+      terms[c][0] = MTHashV1({text, 1});
+    }
+
+    for (size_t c = 0; c < 0x100; c++) {
+      for (size_t n = 1; n < 0x100; n++) {
+        const char text[]{char(c), char(n)};
+        terms[c][n] = MTHashV1({text, 2}) ^ terms[n][0];
+      }
+    }
+  }
+};
+
+// Hash states of partial candidate, can be extended by more text
+struct SearchState {
+  uint32 v1 = 0;
+  uint32 v2 = 0xFFFFFFFF;
+  uint8 v1Last = 0;
+  bool v1Empty = true;
+
+  SearchState Append(const MTHashV1Terms &v1Terms, std::string_view text,
+                     bool searchV1, bool searchV2) const {
+    SearchState retVal = *this;
+
+    if (text.empty()) {
+      return retVal;
+    }
+
+    if (searchV1) {
+      for (uint8 c : text) {
+        if (!retVal.v1Empty) {
+          retVal.v1 ^= v1Terms.terms[retVal.v1Last][c];
+        }
+
+        retVal.v1Last = c;
+        retVal.v1Empty = false;
+      }
+    }
+
+    if (searchV2) {
+      retVal.v2 = MTHashV2(text, retVal.v2);
+    }
+
+    return retVal;
+  }
+
+  uint32 V1(const MTHashV1Terms &v1Terms) const {
+    return v1Empty ? v1 : v1 ^ v1Terms.terms[v1Last][0];
+  }
+
+  uint32 V2() const { return v2 & 0x7FFFFFFF; }
+};
+} // namespace
+
+std::vector<HashSearchResult>
+revil::SearchHashes(std::span<const uint32> targets,
+                    const HashSearchSettings &settings,
+                    HashSearchCallback callback) {
+  static const std::unique_ptr<MTHashV1Terms> v1Terms =
+      std::make_unique<MTHashV1Terms>();
+  std::vector<uint32> sortedTargets;
+
+  for (uint32 t : targets) {
+    sortedTargets.push_back(t & 0x7FFFFFFF);
+  }
+
+  std::sort(sortedTargets.begin(), sortedTargets.end());
+
+  static const std::vector<std::string> emptyList{std::string()};
+  auto &prefixes =
+      settings.prefixes.empty() ? emptyList : settings.prefixes;
+  auto &suffixes =
+      settings.suffixes.empty() ? emptyList : settings.suffixes;
+  auto &tokens = settings.tokens;
+  const bool searchV1 = settings.searchV1;
+  const bool searchV2 = settings.searchV2;
+
+  auto Append = [&](const SearchState &state, std::string_view text) {
+    return state.Append(*v1Terms, text, searchV1, searchV2);
+  };
+
+  // Known prefixes are hashed only once
+  std::vector<SearchState> prefixStates;
+
+  for (auto &p : prefixes) {
+    prefixStates.emplace_back(Append(SearchState{}, p));
+  }
+
+  std::vector<HashSearchResult> results;
+  std::mutex resultsMutex;
+
+  auto IsTarget = [&](uint32 hash) {
+    return std::binary_search(sortedTargets.begin(), sortedTargets.end(),
+                              hash);
+  };
+
+  // Work item = prefix and first token, first token index 0 = no tokens
+  const size_t numFirstTokens =
+      settings.maxTokens ? tokens.size() + 1 : size_t(1);
+  const size_t numItems = prefixes.size() * numFirstTokens;
+  std::atomic_size_t nextItem{0};
+
+  auto Worker = [&] {
+    std::vector<uint32> path;
+    size_t prefixId;
+
+    auto Report = [&](size_t suffixId, uint32 hash, bool isV1) {
+      HashSearchResult result{
+          .hash = hash,
+          .name = prefixes[prefixId],
+          .isV1 = isV1,
+      };
+
+      for (uint32 t : path) {
+        result.name.append(tokens[t]);
+      }
+
+      result.name.append(suffixes[suffixId]);
+
+      std::lock_guard<std::mutex> lg(resultsMutex);
+
+      if (callback) {
+        callback(result);
+      }
+
+      results.emplace_back(std::move(result));
+    };
+
+    auto Leaf = [&](const SearchState &state) {
+      for (size_t s = 0; s < suffixes.size(); s++) {
+        const SearchState sState = Append(state, suffixes[s]);
+
+        if (searchV1) {
+          if (const uint32 hash = sState.V1(*v1Terms); IsTarget(hash)) {
+            Report(s, hash, true);
+          }
+        }
+
+        if (searchV2) {
+          if (const uint32 hash = sState.V2(); IsTarget(hash)) {
+            Report(s, hash, false);
+          }
+        }
+      }
+    };
+
+    auto Recurse = [&](auto &&self, const SearchState &state) -> void {
+      Leaf(state);
+
+      if (path.size() >= settings.maxTokens) {
+        return;
+      }
+
+      for (uint32 t = 0; t < tokens.size(); t++) {
+        path.push_back(t);
+        self(self, Append(state, tokens[t]));
+        path.pop_back();
+      }
+    };
+
+    while (true) {
+      const size_t item = nextItem++;
+
+      if (item >= numItems) {
+        return;
+      }
+
+      prefixId = item / numFirstTokens;
+      const size_t firstToken = item % numFirstTokens;
+      const SearchState &state = prefixStates[prefixId];
+
+      if (!firstToken) {
+        Leaf(state);
+        continue;
+      }
+
+      path.assign(1, firstToken - 1);
+      Recurse(Recurse, Append(state, tokens[firstToken - 1]));
+      path.clear();
+    }
+  };
+
+  const uint32 numThreads =
+      settings.numThreads ? settings.numThreads
+                          : std::max(std::thread::hardware_concurrency(), 1U);
+  std::vector<std::thread> workers;
+
+  for (uint32 t = 1; t < numThreads; t++) {
+    workers.emplace_back(Worker);
+  }
+
+  Worker();
+
+  for (auto &w : workers) {
+    w.join();
+  }
+
+  std::sort(results.begin(), results.end(), [](auto &a, auto &b) {
+    return a.hash == b.hash ? a.name < b.name : a.hash < b.hash;
+  });
+
+  return results;
+}
@@ -1,6 +1,10 @@
 #include "revil/hashreg.hpp"
 #include "database.hpp"
+#include "mapped_file.hpp"
 #include "spike/except.hpp"
+#include <algorithm>
+#include <charconv>
+#include <set>
 #include "spike/reflect/detail/reflector_class.hpp"
 #include "spike/reflect/detail/reflector_enum.hpp"
 
@@ -13,40 +17,222 @@ REFLECT(ENUMERATION(Platform), ENUM_MEMBER(Auto), ENUM_MEMBER(Win32),
         ENUM_MEMBER(CAFE), ENUM_MEMBER(NSW), ENUM_MEMBER(PS4),
         ENUM_MEMBER(Android), ENUM_MEMBER(IOS), ENUM_MEMBER(Win64));
 
+namespace {
+struct Registry {
+  std::unique_ptr<MappedFile> mapped;
+  const Header *header;
+};
+
+// Searched in order, built-in REDB is last unless replaced
+std::vector<Registry> &Registries() {
+  static std::vector<Registry> registries = [] {
+    std::vector<Registry> retVal;
+    retVal.emplace_back(Registry{nullptr, &REDB});
+    return retVal;
+  }();
+
+  return registries;
+}
+
+// Title is always taken from first registry that contains it
+const TitleName *FindRegistryTitle(std::string_view title) {
+  for (auto &r : Registries()) {
+    if (auto found = FindTitle(*r.header, title)) {
+      return found;
+    }
+  }
+
+  return nullptr;
+}
+
+const ResourceClass *FindRegistryClass(uint32 hash, uint8 platform) {
+  for (auto &r : Registries()) {
+    if (auto found = FindResourceClass(*r.header, hash, platform)) {
+      return found;
+    }
+  }
+
+  return nullptr;
+}
+
+// Every relative pointer reachable from header is checked, lookups are
+// safe to use without further bound checks after this
+void ValidateRegistry(std::string_view data, const std::string &path) {
+  auto Invalid = [&] {
+    throw es::RuntimeError("Registry data out of bounds: " + path);
+  };
+
+  auto Check = [&](const void *ptr, size_t size) {
+    const char *begin = static_cast<const char *>(ptr);
+
+    if (begin < data.data() || size > data.size() ||
+        begin > data.data() + data.size() - size) {
+      Invalid();
+    }
+  };
+
+  // Null allowed only for empty arrays
+  auto CheckItems = [&](const auto *items, size_t numItems) {
+    if (numItems) {
+      Check(items, numItems * sizeof(*items));
+    }
+  };
+
+  auto CheckString = [&](const StringEntry &str) {
+    CheckItems(str.operator->(), str.size);
+  };
+
+  auto CheckLookup = [&](const PerfectHash &lookup) {
+    if (lookup.numSlots && !lookup.numSeeds) {
+      Invalid();
+    }
+
+    CheckItems(lookup.seeds.operator->(), lookup.numSeeds);
+    CheckItems(lookup.slots.operator->(), lookup.numSlots);
+  };
+
+  auto CheckClasses = [&](const ResourceClass *classes, size_t numItems) {
+    CheckItems(classes, numItems);
+
+    for (size_t i = 0; i < numItems; i++) {
+      CheckString(classes[i].name);
+      CheckString(classes[i].extension);
+    }
+  };
+
+  auto hdr = reinterpret_cast<const Header *>(data.data());
+
+  CheckItems(hdr->titles.begin(), hdr->titles.numItems);
+  CheckLookup(hdr->titlesLookup);
+
+  for (auto &t : hdr->titles) {
+    CheckString(t.name);
+    const Title *title = t.data.operator->();
+    Check(title, sizeof(Title));
+    auto supports = title->support.operator->();
+    Check(supports, sizeof(*supports) * (NUM_PLATFORMS - 1));
+
+    for (uint32 p = 0; p < NUM_PLATFORMS - 1; p++) {
+      if (auto supp = supports[p].operator->()) {
+        Check(supp, sizeof(TitleSupport));
+        CheckString(supp->arc.key);
+      }
+    }
+
+    CheckItems(title->fixups.begin(), title->fixups.size);
+
+    for (auto &fx : title->fixups) {
+      CheckClasses(fx.classes.operator->(), fx.numItems);
+      CheckLookup(fx.lookup);
+    }
+  }
+
+  for (uint32 p = 0; p < NUM_PLATFORMS; p++) {
+    auto &classes = hdr->resourceClasses[p];
+    CheckClasses(classes.begin(), classes.numItems);
+    CheckLookup(hdr->resourceClassesLookup[p]);
+  }
+
+  CheckItems(hdr->classes.begin(), hdr->classes.numItems);
+
+  for (auto &c : hdr->classes) {
+    CheckString(c.name);
+  }
+
+  for (uint32 i = 0; i < 2; i++) {
+    CheckItems(hdr->extensions[i].begin(), hdr->extensions[i].numItems);
+    CheckLookup(hdr->extensionsLookup[i]);
+
+    for (auto &e : hdr->extensions[i]) {
+      CheckString(e.extension);
+    }
+
+    CheckItems(hdr->extensions4[i].begin(), hdr->extensions4[i].numItems);
+    CheckLookup(hdr->extensions4Lookup[i]);
+
+    for (auto &e : hdr->extensions4[i]) {
+      CheckString(e.extension);
+    }
+  }
+
+  CheckItems(hdr->extensionsN.begin(), hdr->extensionsN.numItems);
+  CheckLookup(hdr->extensionsNLookup);
+
+  for (auto &e : hdr->extensionsN) {
+    CheckString(e.extension);
+    CheckItems(e.hashes.begin(), e.hashes.size);
+  }
+}
+} // namespace
+
 namespace revil {
 
+void LoadRegistry(const std::string &path, RegistryMode mode) {
+  auto mapped = std::make_unique<MappedFile>(path);
+  std::string_view data = mapped->View();
+
+  if (data.size() < sizeof(BlobHeader) + sizeof(Header)) {
+    throw es::RuntimeError("Registry file is too small: " + path);
+  }
+
+  auto blobHdr = reinterpret_cast<const BlobHeader *>(data.data());
+
+  if (blobHdr->id != BlobHeader::ID) {
+    throw es::InvalidHeaderError(blobHdr->id);
+  }
+
+  if (blobHdr->version != BlobHeader::VERSION) {
+    throw es::InvalidVersionError(blobHdr->version);
+  }
+
+  data.remove_prefix(sizeof(BlobHeader));
+
+  if (blobHdr->dataSize != data.size()) {
+    throw es::RuntimeError("Registry file size mismatch: " + path);
+  }
+
+  ValidateRegistry(data, path);
+
+  auto &registries = Registries();
+  Registry registry{
+      .mapped = std::move(mapped),
+      .header = reinterpret_cast<const Header *>(data.data()),
+  };
+
+  if (mode == RegistryMode::Replace) {
+    registries.clear();
+  }
+
+  registries.emplace(registries.begin(), std::move(registry));
+}
+
+void ResetRegistry() {
+  auto &registries = Registries();
+  registries.clear();
+  registries.emplace_back(Registry{nullptr, &REDB});
+}
+
 std::string_view GetExtension(uint32 hash, std::string_view title,
                               Platform platform_) {
   const uint8 platform = uint8(platform_) & PLATFORM_MASK;
 
   if (!title.empty()) {
-    auto oKey = LowerBound(title, REDB.titles);
-
-    if (oKey != REDB.titles.end() && std::string_view(oKey->name) == title) {
+    if (auto oKey = FindRegistryTitle(title)) {
       for (auto &fx : oKey->data->fixups) {
         if (fx.platform == platform) {
-          const ResourceClass *fClasses = fx.classes.operator->();
-
-          for (size_t i = 0; i < fx.numItems; i++) {
-            if (fClasses[i].hash == hash) {
-              return fClasses[i].extension;
-            }
+          if (auto fClass = FindFixupClass(fx, hash)) {
+            return fClass->extension;
           }
         }
       }
     }
   }
 
-  auto foundClass = LowerBound(hash, REDB.resourceClasses[platform]);
-
-  if (foundClass != REDB.resourceClasses[platform].end() &&
-      foundClass->hash == hash) {
+  if (auto foundClass = FindRegistryClass(hash, platform)) {
     return foundClass->extension;
   }
 
-  foundClass = LowerBound(hash, REDB.resourceClasses[0]);
-
-  if (foundClass != REDB.resourceClasses[0].end() && foundClass->hash == hash) {
+  if (auto foundClass = FindRegistryClass(hash, 0)) {
     return foundClass->extension;
   }
 
@@ -54,31 +240,177 @@ std::string_view GetExtension(uint32 hash, std::string_view title,
 }
 
 std::string_view GetClassName(uint32 hash) {
-  auto foundResClass = LowerBound(hash, REDB.resourceClasses[0]);
-
-  if (foundResClass != REDB.resourceClasses[0].end() &&
-      foundResClass->hash == hash) {
+  if (auto foundResClass = FindRegistryClass(hash, 0)) {
     return foundResClass->name;
   }
 
-  auto foundClass = LowerBound(hash, REDB.classes);
+  for (auto &r : Registries()) {
+    auto &classes = r.header->classes;
+    auto foundClass = LowerBound(hash, classes);
 
-  if (foundClass != REDB.classes.end() && foundClass->hash == hash) {
-    return foundClass->name;
+    if (foundClass != classes.end() && foundClass->hash == hash) {
+      return foundClass->name;
+    }
   }
 
   return {};
 }
 
 void GetTitles(TitleCallback cb) {
-  for (auto &p : REDB.titles) {
-    cb(p.name);
+  auto &registries = Registries();
+
+  if (registries.size() == 1) {
+    for (auto &p : registries.front().header->titles) {
+      cb(p.name);
+    }
+
+    return;
+  }
+
+  std::set<std::string_view> titles;
+
+  for (auto &r : registries) {
+    for (auto &p : r.header->titles) {
+      titles.emplace(p.name);
+    }
+  }
+
+  for (auto t : titles) {
+    cb(t);
   }
 }
 
+class TitleContextImpl {
+public:
+  struct FixupExtension {
+    std::string_view extension;
+    uint32 begin;
+    uint32 size;
+  };
+
+  const TitleSupport *support = nullptr;
+  uint8 platform;
+  // Fixups of exact platform, used for extension lookup
+  std::vector<const Fixup *> fixups;
+  // Fixup hashes of exact and common platform, grouped by extension
+  std::vector<FixupExtension> fixupExtensions;
+  std::vector<uint32> fixupHashes;
+
+  TitleContextImpl(std::string_view title, Platform platform_)
+      : platform(uint8(platform_) & PLATFORM_MASK) {
+    if (title.empty()) {
+      return;
+    }
+
+    support = GetTitleSupport(title, platform_);
+    std::vector<std::pair<std::string_view, std::vector<uint32>>> groups;
+
+    for (auto &fx : FindRegistryTitle(title)->data->fixups) {
+      if (fx.platform == platform) {
+        fixups.emplace_back(&fx);
+      }
+
+      if (fx.platform != platform && fx.platform != 0) {
+        continue;
+      }
+
+      const ResourceClass *fClasses = fx.classes.operator->();
+
+      for (size_t i = 0; i < fx.numItems; i++) {
+        std::string_view fExt(fClasses[i].extension);
+        auto found = std::find_if(groups.begin(), groups.end(),
+                                  [&](auto &g) { return g.first == fExt; });
+
+        if (found == groups.end()) {
+          groups.emplace_back(fExt, std::vector<uint32>{});
+          found = std::prev(groups.end());
+        }
+
+        found->second.emplace_back(fClasses[i].hash);
+      }
+    }
+
+    for (auto &[ext, hashes] : groups) {
+      fixupExtensions.emplace_back(FixupExtension{
+          .extension = ext,
+          .begin = uint32(fixupHashes.size()),
+          .size = uint32(hashes.size()),
+      });
+      fixupHashes.insert(fixupHashes.end(), hashes.begin(), hashes.end());
+    }
+  }
+};
+
+TitleContext::TitleContext(std::string_view title, Platform platform)
+    : pi(std::make_unique<TitleContextImpl>(title, platform)) {}
+TitleContext::TitleContext(TitleContext &&) = default;
+TitleContext::~TitleContext() = default;
+
+const TitleSupport *TitleContext::Support() const { return pi->support; }
+
+std::string_view TitleContext::GetExtension(uint32 hash) const {
+  for (auto fx : pi->fixups) {
+    if (auto fClass = FindFixupClass(*fx, hash)) {
+      return fClass->extension;
+    }
+  }
+
+  if (auto foundClass = FindRegistryClass(hash, pi->platform)) {
+    return foundClass->extension;
+  }
+
+  if (auto foundClass = FindRegistryClass(hash, 0)) {
+    return foundClass->extension;
+  }
+
+  return {};
+}
+
+/* Lookup order:
+  title fixups
+  ext maps of title's arc version
+  hashed (numerical) extension
+*/
+std::span<const uint32> TitleContext::GetHash(std::string_view extension) const {
+  for (auto &fx : pi->fixupExtensions) {
+    if (fx.extension == extension) {
+      return {pi->fixupHashes.data() + fx.begin, fx.size};
+    }
+  }
+
+  const bool version1 = pi->support && (pi->support->arc.flags & DbArc_Version1);
+
+  for (auto &r : Registries()) {
+    if (auto spn = ClassesFromExtension(*r.header, extension, version1);
+        spn.size() > 0) {
+      return spn;
+    }
+  }
+
+  // for backward compatibility, some extensions might have numerical (hashed)
+  // extension (not found in main registry) if the extension has been added
+  // later, just find it by hash and verify it in inverted registry
+  uint32 cvted = 0;
+  std::from_chars(extension.data(), extension.data() + extension.size(), cvted,
+                  16);
+
+  if (cvted < 0x10000) {
+    return {};
+  }
+
+  auto extTranslated = GetExtension(cvted);
+
+  if (extTranslated.empty()) {
+    return {};
+  }
+
+  return GetHash(extTranslated);
+}
+
 /* Lookup order:
-  extCommon map
-  if platform not auto lookup class from ext<platform> map
+  title fixups
+  ext maps of title's arc version
+  hashed (numerical) extension
 */
 std::vector<uint32> GetHash(std::string_view extension, std::string_view title,
                             Platform platform_) {
@@ -87,39 +419,36 @@ std::vector<uint32> GetHash(std::string_view extension, std::string_view title,
 
   std::vector<uint32> hashes;
 
-  if (!title.empty()) {
-    auto oKey = LowerBound(title, REDB.titles);
+  for (auto &fx : FindRegistryTitle(title)->data->fixups) {
+    if (fx.platform == platform || fx.platform == 0) {
+      const ResourceClass *fClasses = fx.classes.operator->();
 
-    if (oKey != REDB.titles.end() && std::string_view(oKey->name) == title) {
-      for (auto &fx : oKey->data->fixups) {
-        if (fx.platform == platform || fx.platform == 0) {
-          const ResourceClass *fClasses = fx.classes.operator->();
-
-          for (size_t i = 0; i < fx.numItems; i++) {
-            if (std::string_view fExt(fClasses[i].extension); 
-            fExt == extension) {
-              hashes.emplace_back(fClasses[i].hash);
-            }
-          }
+      for (size_t i = 0; i < fx.numItems; i++) {
+        if (std::string_view fExt(fClasses[i].extension); fExt == extension) {
+          hashes.emplace_back(fClasses[i].hash);
         }
       }
     }
   }
 
-  if (hashes.empty()) {
-    auto spn =
-        ClassesFromExtension(REDB, extension, supp->arc.flags & DbArc_Version1);
-    if (spn.size() > 0) {
+  if (!hashes.empty()) {
+    return hashes;
+  }
+
+  for (auto &r : Registries()) {
+    if (auto spn = ClassesFromExtension(*r.header, extension,
+                                        supp->arc.flags & DbArc_Version1);
+        spn.size() > 0) {
       return {spn.begin(), spn.end()};
     }
-  } else {
-    return hashes;
   }
 
   // for backward compatibility, some extensions might have numerical (hashed)
   // extension (not found in main registry) if the extension has been added
   // later, just find it by hash and verify it in inverted registry
-  auto cvted = strtoul(extension.data(), nullptr, 16);
+  uint32 cvted = 0;
+  std::from_chars(extension.data(), extension.data() + extension.size(), cvted,
+                  16);
 
   if (cvted < 0x10000) {
     return {};
@@ -135,9 +464,9 @@ std::vector<uint32> GetHash(std::string_view extension, std::string_view title,
 }
 
 Platforms GetPlatformSupport(std::string_view title) {
-  auto found = LowerBound(title, REDB.titles);
+  auto found = FindRegistryTitle(title);
 
-  if (found == REDB.titles.end() || found->name != title) {
+  if (!found) {
     throw es::RuntimeError("Coundn't find title.");
   }
 
@@ -156,9 +485,9 @@ Platforms GetPlatformSupport(std::string_view title) {
 }
 
 const TitleSupport *GetTitleSupport(std::string_view title, Platform platform) {
-  auto found = LowerBound(title, REDB.titles);
+  auto found = FindRegistryTitle(title);
 
-  if (found == REDB.titles.end() || found->name != title) {
+  if (!found) {
     throw es::RuntimeError("Coundn't find title.");
   }
 
@@ -17,7 +17,9 @@
 
 #pragma once
 #include "spike/io/binreader_stream.hpp"
-#include <sstream>
+#include <algorithm>
+#include <istream>
+#include <streambuf>
 
 static constexpr uint32 SFHID = CompileFourCC("\0SFH");
 
@@ -36,32 +38,129 @@ struct HFS {
   }
 };
 
-inline std::stringstream ProcessHFS(BinReaderRef_e rd) {
-  std::stringstream str;
-  constexpr int64 chunkSize = 0x20000;
-  char tempBuffer[chunkSize];
-  HFS hdr;
-  rd.Read(hdr);
+// Seekable view of HFS payload, chunk trailers are skipped on the fly
+// and underlying stream is read in place, one chunk at a time.
+class HFSStreamBuf : public std::streambuf {
+public:
+  static constexpr int64 CHUNK_SIZE = 0x20000;
+  static constexpr int64 CHUNK_DATA_SIZE = CHUNK_SIZE - 16;
 
-  if (hdr.id == SFHID) {
-    hdr.SwapEndian();
+  explicit HFSStreamBuf(BinReaderRef_e rd_) : rd(rd_) {
+    HFS hdr;
+    rd.Read(hdr);
+
+    if (hdr.id == SFHID) {
+      hdr.SwapEndian();
+    }
+
+    dataBegin = rd.Tell();
+    fileSize = hdr.fileSize;
+    // Last chunk holds whatever is left, that can be more than
+    // CHUNK_DATA_SIZE
+    numFullChunks = fileSize < CHUNK_SIZE
+                        ? 0
+                        : (fileSize - CHUNK_SIZE) / CHUNK_DATA_SIZE + 1;
+    setg(buffer, buffer, buffer);
+  }
+
+  int64 Size() const { return fileSize; }
+
+protected:
+  int_type underflow() override {
+    if (gptr() < egptr()) {
+      return traits_type::to_int_type(*gptr());
+    }
+
+    const int64 position = bufferBegin + (egptr() - eback());
+
+    if (!LoadChunk(position)) {
+      return traits_type::eof();
+    }
+
+    return traits_type::to_int_type(*gptr());
+  }
+
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                   std::ios_base::openmode which) override {
+    if (!(which & std::ios_base::in)) {
+      return pos_type(off_type(-1));
+    }
+
+    int64 position = off;
+
+    if (dir == std::ios_base::cur) {
+      position += bufferBegin + (gptr() - eback());
+    } else if (dir == std::ios_base::end) {
+      position += fileSize;
+    }
+
+    return seekpos(pos_type(position), which);
   }
 
-  int64 fileSize = hdr.fileSize;
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+    const int64 position = pos;
 
-  while (true) {
-    if (fileSize < chunkSize) {
-      rd.ReadBuffer(tempBuffer, fileSize);
-      str.write(tempBuffer, fileSize);
-      rd.ApplyPadding(16);
-      rd.Skip(16);
-      break;
+    if (!(which & std::ios_base::in) || position < 0 || position > fileSize) {
+      return pos_type(off_type(-1));
     }
 
-    rd.ReadBuffer(tempBuffer, chunkSize);
-    str.write(tempBuffer, chunkSize - 16);
-    fileSize -= chunkSize - 16;
+    const int64 bufferEnd = bufferBegin + (egptr() - eback());
+
+    if (position >= bufferBegin && position < bufferEnd) {
+      setg(buffer, buffer + (position - bufferBegin), egptr());
+    } else {
+      // Defer read until data is actually requested
+      bufferBegin = position;
+      setg(buffer, buffer, buffer);
+    }
+
+    return pos;
   }
 
-  return str;
-}
+  std::streamsize showmanyc() override {
+    const int64 position = bufferBegin + (gptr() - eback());
+    return position < fileSize ? fileSize - position : -1;
+  }
+
+private:
+  BinReaderRef_e rd;
+  int64 dataBegin = 0;
+  int64 fileSize = 0;
+  int64 bufferBegin = 0;
+  int64 numFullChunks = 0;
+  char buffer[CHUNK_SIZE];
+
+  bool LoadChunk(int64 position) {
+    if (position >= fileSize) {
+      bufferBegin = fileSize;
+      setg(buffer, buffer, buffer);
+      return false;
+    }
+
+    const int64 chunkIndex =
+        std::min(position / CHUNK_DATA_SIZE, numFullChunks);
+    const int64 chunkBegin = chunkIndex * CHUNK_DATA_SIZE;
+    const int64 chunkDataSize = chunkIndex < numFullChunks
+                                    ? CHUNK_DATA_SIZE
+                                    : fileSize - chunkBegin;
+    rd.Seek(dataBegin + chunkIndex * CHUNK_SIZE);
+    rd.ReadBuffer(buffer, chunkDataSize);
+    bufferBegin = chunkBegin;
+    setg(buffer, buffer + (position - chunkBegin), buffer + chunkDataSize);
+
+    return true;
+  }
+};
+
+class HFSStream : public std::istream {
+public:
+  // Reads HFS header at current position of rd
+  explicit HFSStream(BinReaderRef_e rd) : std::istream(nullptr), buf(rd) {
+    rdbuf(&buf);
+  }
+
+  int64 Size() const { return buf.Size(); }
+
+private:
+  HFSStreamBuf buf;
+};
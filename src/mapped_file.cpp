@@ -0,0 +1,116 @@
+/*  Revil Format Library
+    Copyright(C) 2026 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "mapped_file.hpp"
+#include "spike/except.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+MappedFile::MappedFile(const std::string &path) {
+  fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (fileHandle == INVALID_HANDLE_VALUE) {
+    fileHandle = nullptr;
+    throw es::FileNotFoundError(path);
+  }
+
+  LARGE_INTEGER fileSize;
+  GetFileSizeEx(fileHandle, &fileSize);
+  size = fileSize.QuadPart;
+
+  if (!size) {
+    return;
+  }
+
+  mappingHandle =
+      CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+  if (!mappingHandle) {
+    CloseHandle(fileHandle);
+    throw es::RuntimeError("Cannot map file: " + path);
+  }
+
+  data = static_cast<const char *>(
+      MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+
+  if (!data) {
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    throw es::RuntimeError("Cannot map file: " + path);
+  }
+}
+
+MappedFile::~MappedFile() {
+  if (data) {
+    UnmapViewOfFile(data);
+  }
+
+  if (mappingHandle) {
+    CloseHandle(mappingHandle);
+  }
+
+  if (fileHandle) {
+    CloseHandle(fileHandle);
+  }
+}
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string &path) {
+  int fd = open(path.c_str(), O_RDONLY);
+
+  if (fd < 0) {
+    throw es::FileNotFoundError(path);
+  }
+
+  struct stat fileStat;
+
+  if (fstat(fd, &fileStat) < 0) {
+    close(fd);
+    throw es::FileNotFoundError(path);
+  }
+
+  size = fileStat.st_size;
+
+  if (!size) {
+    close(fd);
+    return;
+  }
+
+  void *mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  // Mapping keeps its own reference to file
+  close(fd);
+
+  if (mapped == MAP_FAILED) {
+    throw es::RuntimeError("Cannot map file: " + path);
+  }
+
+  data = static_cast<const char *>(mapped);
+}
+
+MappedFile::~MappedFile() {
+  if (data) {
+    munmap(const_cast<char *>(data), size);
+  }
+}
+#endif
@@ -16,10 +16,12 @@
 */
 
 #include "bone_track.hpp"
+#include "codecs.hpp"
 #include "fixup_storage.hpp"
 #include "pugixml.hpp"
 #include "spike/reflect/reflector_xml.hpp"
 #include "spike/uni/deleter_hybrid.hpp"
+#include <algorithm>
 
 MAKE_ENUM(ENUMSCOPE(class TrackType_er
                     : uint8, TrackType_er),
@@ -76,27 +78,87 @@ int32 LMTTrackInterface::GetFrame(size_t frame) const {
 }
 
 void LMTTrackInterface::GetValue(Vector4A16 &out, float time) const {
-  float frameDelta = time * frameRate;
+  LMTTrackCursor cursor;
+  GetValue(out, time, cursor);
+}
+
+// Sampling over codec typed by VisitCodec, calls into codec are direct
+template <class Codec>
+static void EvaluateKey(const LMTTrackInterface &track, const Codec &codec,
+                        Vector4A16 &out, size_t key) {
+  codec.Evaluate(out, key);
+
+  if (track.useMinMax) {
+    out = track.minMax.max + track.minMax.min * out;
+  }
+}
+
+template <class Codec>
+static size_t FindCodecKey(const Codec &codec, int32 frame,
+                           LMTTrackCursor &cursor) {
+  const std::span<const int16> frames = codec.Frames();
+  const size_t numKeys = codec.NumFrames();
+
+  auto KeyFrame = [&](size_t key) -> int32 {
+    return frames.empty() ? codec.GetFrame(key) : frames[key];
+  };
+
+  auto InSpan = [&](size_t key) {
+    return key + 1 < numKeys && KeyFrame(key) <= frame &&
+           KeyFrame(key + 1) > frame;
+  };
+
+  if (InSpan(cursor.key)) {
+    return cursor.key;
+  }
+
+  if (InSpan(cursor.key + 1)) {
+    return ++cursor.key;
+  }
+
+  // First key with frame greater than searched one, keys are sorted
+  size_t begin = 1;
+  size_t len = numKeys - 1;
+
+  while (len > 0) {
+    const size_t half = len / 2;
+
+    if (KeyFrame(begin + half) <= frame) {
+      begin += half + 1;
+      len -= half + 1;
+    } else {
+      len = half;
+    }
+  }
+
+  cursor.key = begin - 1;
+  return cursor.key;
+}
+
+template <class Codec>
+static void SampleValue(const LMTTrackInterface &track, const Codec &codec,
+                        Vector4A16 &out, float time, LMTTrackCursor &cursor) {
+  float frameDelta = time * track.frameRate;
   int32 frame = static_cast<int32>(frameDelta);
-  const size_t numCtrFrames = controller->NumFrames();
+  const size_t numCtrFrames = codec.NumFrames();
 
   if (!numCtrFrames) {
-    if (useRefFrame) {
-      out = GetRefData();
+    if (track.useRefFrame) {
+      out = track.GetRefData();
     }
 
     return;
   }
 
-  if (useRefFrame) {
-    if (loopFrame < 1) {
+  if (track.useRefFrame) {
+    if (track.loopFrame < 1) {
       if (!frame) {
         if (frameDelta < 0.0001f) {
-          out = GetRefData();
+          out = track.GetRefData();
         } else {
           frameDelta -= frame;
-          Evaluate(out, 0);
-          out = GetRefData() + (out - GetRefData()) * frameDelta;
+          EvaluateKey(track, codec, out, 0);
+          out = track.GetRefData() + (out - track.GetRefData()) * frameDelta;
         }
 
         return;
@@ -107,25 +169,93 @@ void LMTTrackInterface::GetValue(Vector4A16 &out, float time) const {
     }
   }
 
-  const int32 maxFrame = controller->GetFrame(numCtrFrames - 1);
+  const int32 maxFrame = codec.GetFrame(numCtrFrames - 1);
 
   if (frame >= maxFrame) {
-    Evaluate(out, numCtrFrames - 1);
+    EvaluateKey(track, codec, out, numCtrFrames - 1);
   } else {
-    for (size_t f = 1; f < numCtrFrames; f++) {
-      int32 cFrame = controller->GetFrame(f);
+    const size_t key = FindCodecKey(codec, frame, cursor);
+    const float boundFrame = static_cast<float>(codec.GetFrame(key + 1));
+    const float prevFrame = static_cast<float>(codec.GetFrame(key));
+
+    frameDelta = (prevFrame - frameDelta) / (prevFrame - boundFrame);
+
+    codec.Interpolate(out, key, frameDelta, track.minMax);
+  }
+}
+
+template <class Codec>
+static void SampleValues(const LMTTrackInterface &track, const Codec &codec,
+                         std::span<Vector4A16> out,
+                         std::span<const float> times) {
+  const size_t numSamples = std::min(out.size(), times.size());
+  LMTTrackCursor cursor;
+
+  if (codec.Frames().empty()) {
+    for (size_t i = 0; i < numSamples; i++) {
+      SampleValue(track, codec, out[i], times[i], cursor);
+    }
+
+    return;
+  }
+
+  // Samples between keys are interpolated by codec in batches,
+  // reference frame and last key samples go through SampleValue
+  const int32 maxFrame = codec.GetFrame(codec.NumFrames() - 1);
+  std::vector<float> batchFrames;
+  size_t batchBegin = 0;
+
+  auto Flush = [&] {
+    if (batchFrames.empty()) {
+      return;
+    }
 
-      if (cFrame > frame) {
-        const float boundFrame = static_cast<float>(cFrame);
-        const float prevFrame = static_cast<float>(controller->GetFrame(f - 1));
+    codec.InterpolateFrames(out.subspan(batchBegin, batchFrames.size()),
+                            batchFrames, track.minMax);
+    batchFrames.clear();
+  };
 
-        frameDelta = (prevFrame - frameDelta) / (prevFrame - boundFrame);
+  for (size_t i = 0; i < numSamples; i++) {
+    float frameDelta = times[i] * track.frameRate;
+    int32 frame = static_cast<int32>(frameDelta);
+    bool useBatch = true;
 
-        controller->Interpolate(out, f - 1, frameDelta, minMax);
-        break;
+    if (track.useRefFrame && track.loopFrame < 1) {
+      if (!frame) {
+        useBatch = false;
+      } else {
+        frame--;
+        frameDelta -= 1.f;
+      }
+    }
+
+    if (useBatch && frame < maxFrame) {
+      if (batchFrames.empty()) {
+        batchBegin = i;
       }
+
+      batchFrames.push_back(frameDelta);
+      continue;
     }
+
+    Flush();
+    SampleValue(track, codec, out[i], times[i], cursor);
   }
+
+  Flush();
+}
+
+void LMTTrackInterface::GetValue(Vector4A16 &out, float time,
+                                 LMTTrackCursor &cursor) const {
+  VisitCodec(*controller, [&](auto &codec) {
+    SampleValue(*this, codec, out, time, cursor);
+  });
+}
+
+void LMTTrackInterface::GetValues(std::span<Vector4A16> out,
+                                  std::span<const float> times) const {
+  VisitCodec(*controller,
+             [&](auto &codec) { SampleValues(*this, codec, out, times); });
 }
 
 uni::MotionTrack::TrackType_e LMTTrackInterface::TrackType() const {
@@ -38,6 +38,10 @@ struct LMTTrackInterface : LMTTrack {
                    size_t frame) const override;
   void Evaluate(Vector4A16 &out, size_t frame) const override;
   void GetValue(Vector4A16 &output, float time) const override;
+  void GetValue(Vector4A16 &output, float time,
+                LMTTrackCursor &cursor) const override;
+  void GetValues(std::span<Vector4A16> out,
+                 std::span<const float> times) const override;
   int32 GetFrame(size_t frame) const override;
 
   MotionTrack::TrackType_e TrackType() const override;
@@ -22,7 +22,9 @@
 #include "spike/reflect/reflector_xml.hpp"
 #include "spike/util/macroLoop.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <sstream>
 #include <unordered_map>
 
@@ -969,6 +971,231 @@ void Buff_EvalShared<C>::Assign(char *ptr, size_t size, bool swapEndian) {
   }
 }
 
+#if defined(__x86_64__) || defined(_M_X64)
+#define RE_LMT_AVX2
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define RE_TARGET_AVX2
+#else
+#include <cpuid.h>
+#define RE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#include <immintrin.h>
+
+static bool HasAVX2() {
+  uint32 regs[4]{};
+#ifdef _MSC_VER
+  __cpuid(reinterpret_cast<int *>(regs), 1);
+#else
+  __get_cpuid(1, &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif
+  // ecx: OSXSAVE, AVX
+  if (!(regs[2] & (1 << 27)) || !(regs[2] & (1 << 28))) {
+    return false;
+  }
+
+  // OS must preserve ymm registers
+#ifdef _MSC_VER
+  const uint64 xcr0 = _xgetbv(0);
+#else
+  uint32 xcr0Lo, xcr0Hi;
+  asm("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+  const uint64 xcr0 = xcr0Lo | (uint64(xcr0Hi) << 32);
+#endif
+
+  if ((xcr0 & 6) != 6) {
+    return false;
+  }
+
+#ifdef _MSC_VER
+  __cpuidex(reinterpret_cast<int *>(regs), 7, 0);
+#else
+  __get_cpuid_count(7, 0, &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif
+  // ebx: AVX2
+  return regs[1] & (1 << 5);
+}
+
+// Low 32 bits of 64 bit (hi:lo) shift right
+RE_TARGET_AVX2 static inline __m256i BulkShift(__m256i lo, __m256i hi,
+                                               uint32 shift) {
+  if (shift < 32) {
+    return _mm256_or_si256(
+        _mm256_srl_epi32(lo, _mm_cvtsi32_si128(shift)),
+        _mm256_sll_epi32(hi, _mm_cvtsi32_si128(32 - shift)));
+  }
+
+  return _mm256_srl_epi32(hi, _mm_cvtsi32_si128(shift - 32));
+}
+
+// Decodes keys in blocks of 8, every component of 8 keys at once.
+// Operations are the same as in scalar Evaluate and additiveLerp.
+// Returns number of decoded keys.
+RE_TARGET_AVX2 static size_t BulkEvaluateAVX2(const LMTBulkLayout &layout,
+                                              const char *keys, size_t stride,
+                                              size_t numKeys, Vector4A16 *out,
+                                              const TrackMinMax &minMax) {
+  const __m256 multiplier = _mm256_set1_ps(layout.multiplier);
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 negOne = _mm256_set1_ps(-1.0f);
+  __m256 mins[4];
+  __m256 maxs[4];
+  __m256 masks[4];
+  __m256 signMaxs[4];
+
+  for (uint32 c = 0; c < 4; c++) {
+    mins[c] = _mm256_set1_ps(minMax.min[c]);
+    maxs[c] = _mm256_set1_ps(minMax.max[c]);
+    masks[c] = _mm256_set1_ps(static_cast<float>(layout.components[c].mask));
+    signMaxs[c] = _mm256_mul_ps(masks[c], _mm256_set1_ps(0.5f));
+  }
+
+  size_t k = 0;
+
+  for (; k + 8 <= numKeys; k += 8) {
+    alignas(32) uint32 rawLo[8];
+    alignas(32) uint32 rawHi[8];
+
+    for (size_t i = 0; i < 8; i++) {
+      uint64 raw = 0;
+      memcpy(&raw, keys + (k + i) * stride, stride);
+      rawLo[i] = static_cast<uint32>(raw);
+      rawHi[i] = static_cast<uint32>(raw >> 32);
+    }
+
+    const __m256i lo = _mm256_load_si256(reinterpret_cast<__m256i *>(rawLo));
+    const __m256i hi = _mm256_load_si256(reinterpret_cast<__m256i *>(rawHi));
+    __m256 comps[4];
+
+    for (uint32 c = 0; c < 4; c++) {
+      const LMTBulkComponent &comp = layout.components[c];
+      __m256i value =
+          _mm256_sll_epi32(BulkShift(lo, hi, comp.shiftHigh),
+                           _mm_cvtsi32_si128(comp.shiftHighLeft));
+      value = _mm256_or_si256(
+          value, _mm256_and_si256(BulkShift(lo, hi, comp.shiftLow),
+                                  _mm256_set1_epi32(comp.maskLow)));
+      value = _mm256_and_si256(value, _mm256_set1_epi32(comp.mask));
+      __m256 fValue = _mm256_cvtepi32_ps(value);
+
+      if (layout.signedComponents) {
+        const __m256 signedHalf = _mm256_sub_ps(masks[c], fValue);
+        const __m256 multSign = _mm256_and_ps(
+            _mm256_cmp_ps(fValue, signMaxs[c], _CMP_GT_OQ), negOne);
+        fValue = _mm256_mul_ps(fValue, _mm256_add_ps(multSign, one));
+        fValue = _mm256_add_ps(fValue, _mm256_mul_ps(signedHalf, multSign));
+      }
+
+      fValue = _mm256_mul_ps(fValue, multiplier);
+
+      if (layout.useMinMax) {
+        fValue = _mm256_add_ps(maxs[c], _mm256_mul_ps(mins[c], fValue));
+      }
+
+      comps[c] = fValue;
+    }
+
+    // Components of 8 keys into 8 vectors
+    const __m256 xy0 = _mm256_unpacklo_ps(comps[0], comps[1]);
+    const __m256 xy1 = _mm256_unpackhi_ps(comps[0], comps[1]);
+    const __m256 zw0 = _mm256_unpacklo_ps(comps[2], comps[3]);
+    const __m256 zw1 = _mm256_unpackhi_ps(comps[2], comps[3]);
+    const __m256 vecs[4]{
+        _mm256_shuffle_ps(xy0, zw0, _MM_SHUFFLE(1, 0, 1, 0)),
+        _mm256_shuffle_ps(xy0, zw0, _MM_SHUFFLE(3, 2, 3, 2)),
+        _mm256_shuffle_ps(xy1, zw1, _MM_SHUFFLE(1, 0, 1, 0)),
+        _mm256_shuffle_ps(xy1, zw1, _MM_SHUFFLE(3, 2, 3, 2)),
+    };
+
+    for (size_t i = 0; i < 4; i++) {
+      _mm_store_ps(reinterpret_cast<float *>(out + k + i),
+                   _mm256_castps256_ps128(vecs[i]));
+      _mm_store_ps(reinterpret_cast<float *>(out + k + i + 4),
+                   _mm256_extractf128_ps(vecs[i], 1));
+    }
+  }
+
+  return k;
+}
+#endif
+
+// Evaluate of every key, with additiveLerp if layout uses it
+template <class C>
+static void BulkEvaluate(std::span<const C> keys, Vector4A16 *out,
+                         const TrackMinMax &minMax) {
+  constexpr const LMTBulkLayout &layout = C::BULK_LAYOUT;
+  size_t done = 0;
+
+#ifdef RE_LMT_AVX2
+  static const bool hasAVX2 = HasAVX2();
+
+  if (hasAVX2) {
+    done = BulkEvaluateAVX2(layout, reinterpret_cast<const char *>(keys.data()),
+                            sizeof(C), keys.size(), out, minMax);
+  }
+#endif
+
+  for (size_t k = done; k < keys.size(); k++) {
+    keys[k].Evaluate(out[k]);
+
+    if constexpr (layout.useMinMax) {
+      out[k] = additiveLerp(minMax, out[k]);
+    }
+  }
+}
+
+template <class C>
+void Buff_EvalShared<C>::InterpolateFrames(std::span<Vector4A16> out,
+                                           std::span<const float> sampleFrames,
+                                           const TrackMinMax &bounds) const {
+  // Key of every sample, same search as in LMTTrackInterface::GetValue
+  std::vector<uint32> keys(out.size());
+  size_t key = 0;
+
+  for (size_t i = 0; i < out.size(); i++) {
+    const int32 frame = static_cast<int32>(sampleFrames[i]);
+
+    if (frame < frames[key]) {
+      key = 0;
+    }
+
+    while (frames[key + 1] <= frame) {
+      key++;
+    }
+
+    keys[i] = key;
+  }
+
+  auto Delta = [&](size_t i) {
+    const float boundFrame = static_cast<float>(frames[keys[i] + 1]);
+    const float prevFrame = static_cast<float>(frames[keys[i]]);
+    return (prevFrame - sampleFrames[i]) / (prevFrame - boundFrame);
+  };
+
+  if constexpr (requires { C::BULK_LAYOUT; }) {
+    if (out.empty()) {
+      return;
+    }
+
+    // Used keys are decoded once, then only interpolated
+    const uint32 firstKey = *std::min_element(keys.begin(), keys.end());
+    const uint32 lastKey = *std::max_element(keys.begin(), keys.end()) + 1;
+    std::vector<Vector4A16> evaluated(lastKey - firstKey + 1);
+    BulkEvaluate<C>(std::span<const C>(data).subspan(firstKey, evaluated.size()),
+                    evaluated.data(), bounds);
+
+    for (size_t i = 0; i < out.size(); i++) {
+      const size_t eKey = keys[i] - firstKey;
+      out[i] = slerp(evaluated[eKey], evaluated[eKey + 1], Delta(i));
+    }
+  } else {
+    for (size_t i = 0; i < out.size(); i++) {
+      data[keys[i]].Interpolate(out[i], data[keys[i] + 1], Delta(i), bounds);
+    }
+  }
+}
+
 template <class C> void Buff_EvalShared<C>::Save(BinWritterRef wr) const {
   if constexpr (!C::VARIABLE_SIZE) {
     if (!wr.SwappedEndian()) {
@@ -992,6 +1219,15 @@ template <class C> void Buff_EvalShared<C>::SwapEndian() {
   }
 }
 
+#define TCON_INST(val) template struct Buff_EvalShared<Buf_##val>;
+
+StaticFor(TCON_INST, SingleVector3, HermiteVector3, StepRotationQuat3,
+          SphericalRotation, LinearVector3, BiLinearVector3_16bit,
+          BiLinearVector3_8bit, LinearRotationQuat4_14bit,
+          BiLinearRotationQuat4_7bit, BiLinearRotationQuatXW_14bit,
+          BiLinearRotationQuatYW_14bit, BiLinearRotationQuatZW_14bit,
+          BiLinearRotationQuat4_11bit, BiLinearRotationQuat4_9bit)
+
 template <class Derived> LMTTrackController *_creatorDummyBuffEval() {
   return new Buff_EvalShared<Derived>();
 }
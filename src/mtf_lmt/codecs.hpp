@@ -17,13 +17,36 @@
 
 #pragma once
 #include "internal.hpp"
+#include "spike/except.hpp"
 #include "spike/reflect/reflector.hpp"
 #include "spike/type/flags.hpp"
+#include "spike/util/macroLoop.hpp"
 #include <span>
 
 static constexpr float fPI = 3.14159265f;
 static constexpr float fPI2 = 0.5 * fPI;
 
+// Bit layout of packed rotation codec for bulk decoding of keys,
+// raw = little endian bits of key
+// value = ((raw >> shiftHigh) << shiftHighLeft | (raw >> shiftLow) & maskLow)
+//         & mask
+struct LMTBulkComponent {
+  uint8 shiftHigh;
+  uint8 shiftHighLeft;
+  uint8 shiftLow;
+  uint32 maskLow;
+  uint32 mask;
+};
+
+struct LMTBulkLayout {
+  LMTBulkComponent components[4];
+  float multiplier;
+  // Sign encoding of Buf_LinearRotationQuat4_14bit
+  bool signedComponents = false;
+  // Keys are interpolated after additiveLerp with track bounds
+  bool useMinMax = true;
+};
+
 struct Buf_SingleVector3 {
   Vector data;
 
@@ -241,6 +264,18 @@ struct Buf_LinearRotationQuat4_14bit : Buf_SphericalRotation {
       static_cast<float>(componentMask) / 4.0f;
   static constexpr float componentMultiplier = 1.0f / componentMultiplierInv;
 
+  static constexpr LMTBulkLayout BULK_LAYOUT{
+      .components{
+          {42, 0, 0, 0, componentMask},
+          {28, 0, 0, 0, componentMask},
+          {14, 0, 0, 0, componentMask},
+          {0, 0, 0, 0, componentMask},
+      },
+      .multiplier = componentMultiplier,
+      .signedComponents = true,
+      .useMinMax = false,
+  };
+
   void Evaluate(Vector4A16 &out) const;
 
   void Devaluate(const Vector4A16 &in);
@@ -269,6 +304,16 @@ struct Buf_BiLinearRotationQuat4_7bit {
   static constexpr uint32 dataField = (1 << 28) - 1;
   static constexpr uint32 frameField = ~dataField;
 
+  static constexpr LMTBulkLayout BULK_LAYOUT{
+      .components{
+          {21, 0, 0, 0, componentMask},
+          {14, 0, 0, 0, componentMask},
+          {7, 0, 0, 0, componentMask},
+          {0, 0, 0, 0, componentMask},
+      },
+      .multiplier = componentMultiplier,
+  };
+
   void Evaluate(Vector4A16 &out) const;
 
   void Devaluate(const Vector4A16 &in);
@@ -292,6 +337,16 @@ struct Buf_BiLinearRotationQuatXW_14bit : Buf_BiLinearRotationQuat4_7bit {
       static_cast<float>(componentMask);
   static constexpr float componentMultiplier = 1.0f / componentMultiplierInv;
 
+  static constexpr LMTBulkLayout BULK_LAYOUT{
+      .components{
+          {0, 0, 0, 0, componentMask},
+          {},
+          {},
+          {14, 0, 0, 0, componentMask},
+      },
+      .multiplier = componentMultiplier,
+  };
+
   void Evaluate(Vector4A16 &out) const;
 
   void Devaluate(const Vector4A16 &in);
@@ -302,6 +357,16 @@ struct Buf_BiLinearRotationQuatXW_14bit : Buf_BiLinearRotationQuat4_7bit {
 };
 
 struct Buf_BiLinearRotationQuatYW_14bit : Buf_BiLinearRotationQuatXW_14bit {
+  static constexpr LMTBulkLayout BULK_LAYOUT{
+      .components{
+          {},
+          {0, 0, 0, 0, componentMask},
+          {},
+          {14, 0, 0, 0, componentMask},
+      },
+      .multiplier = componentMultiplier,
+  };
+
   void Evaluate(Vector4A16 &out) const;
 
   void Devaluate(const Vector4A16 &in);
@@ -312,6 +377,16 @@ struct Buf_BiLinearRotationQuatYW_14bit : Buf_BiLinearRotationQuatXW_14bit {
 };
 
 struct Buf_BiLinearRotationQuatZW_14bit : Buf_BiLinearRotationQuatXW_14bit {
+  static constexpr LMTBulkLayout BULK_LAYOUT{
+      .components{
+          {},
+          {},
+          {0, 0, 0, 0, componentMask},
+          {14, 0, 0, 0, componentMask},
+      },
+      .multiplier = componentMultiplier,
+  };
+
   void Evaluate(Vector4A16 &out) const;
 
   void Devaluate(const Vector4A16 &in);
@@ -338,6 +413,16 @@ struct Buf_BiLinearRotationQuat4_11bit {
       static_cast<float>(componentMask);
   static constexpr float componentMultiplier = 1.0f / componentMultiplierInv;
 
+  static constexpr LMTBulkLayout BULK_LAYOUT{
+      .components{
+          {0, 0, 0, 0, componentMask},
+          {11, 6, 16, 0x3f, componentMask},
+          {22, 1, 32, 1, componentMask},
+          {33, 0, 0, 0, componentMask},
+      },
+      .multiplier = componentMultiplier,
+  };
+
   void Evaluate(Vector4A16 &out) const;
 
   void Devaluate(const Vector4A16 &in);
@@ -368,6 +453,16 @@ struct Buf_BiLinearRotationQuat4_9bit {
       static_cast<float>(componentMask);
   static constexpr float componentMultiplier = 1.0f / componentMultiplierInv;
 
+  static constexpr LMTBulkLayout BULK_LAYOUT{
+      .components{
+          {0, 1, 8, 1, componentMask},
+          {9, 2, 16, 3, componentMask},
+          {18, 3, 24, 7, componentMask},
+          {27, 4, 32, 0xf, componentMask},
+      },
+      .multiplier = componentMultiplier,
+  };
+
   void Evaluate(Vector4A16 &out) const;
 
   void Devaluate(const Vector4A16 &in);
@@ -381,12 +476,36 @@ struct Buf_BiLinearRotationQuat4_9bit {
   void SwapEndian() {}
 };
 
-template <class C> struct Buff_EvalShared : LMTTrackController {
+template <class C> constexpr TrackTypesShared LMT_CODEC_TYPE =
+    TrackTypesShared::None;
+
+#define LMTCODEC_TYPE(val)                                                     \
+  template <>                                                                  \
+  constexpr TrackTypesShared LMT_CODEC_TYPE<Buf_##val> = TrackTypesShared::val;
+
+StaticFor(LMTCODEC_TYPE, SingleVector3, HermiteVector3, StepRotationQuat3,
+          SphericalRotation, LinearVector3, BiLinearVector3_16bit,
+          BiLinearVector3_8bit, LinearRotationQuat4_14bit,
+          BiLinearRotationQuat4_7bit, BiLinearRotationQuatXW_14bit,
+          BiLinearRotationQuatYW_14bit, BiLinearRotationQuatZW_14bit,
+          BiLinearRotationQuat4_11bit, BiLinearRotationQuat4_9bit)
+
+// Final, calls through Buff_EvalShared<C> are resolved at compile time
+template <class C> struct Buff_EvalShared final : LMTTrackController {
   std::span<C> data;
   std::vector<C> internalData;
   std::vector<int16> frames;
 
+  TrackTypesShared CodecType() const override { return LMT_CODEC_TYPE<C>; }
+
   int32 GetFrame(size_t frame) const override { return frames[frame]; }
+  std::span<const int16> Frames() const override {
+    if (frames.size() != data.size()) {
+      return {};
+    }
+
+    return frames;
+  }
   size_t NumFrames() const override { return data.size(); }
   void NumFrames(size_t numItems) override {
     internalData.resize(numItems);
@@ -410,6 +529,10 @@ template <class C> struct Buff_EvalShared : LMTTrackController {
     data[frame].Interpolate(out, data[frame + 1], delta, bounds);
   }
 
+  void InterpolateFrames(std::span<Vector4A16> out,
+                         std::span<const float> sampleFrames,
+                         const TrackMinMax &bounds) const override;
+
   void Devaluate(const Vector4A16 &in, size_t frame) override {
     data[frame].Devaluate(in);
   }
@@ -424,3 +547,35 @@ template <class C> struct Buff_EvalShared : LMTTrackController {
 
   void Save(BinWritterRef wr) const override;
 };
+
+#define LMTCODEC_EXTERN(val) extern template struct Buff_EvalShared<Buf_##val>;
+
+StaticFor(LMTCODEC_EXTERN, SingleVector3, HermiteVector3, StepRotationQuat3,
+          SphericalRotation, LinearVector3, BiLinearVector3_16bit,
+          BiLinearVector3_8bit, LinearRotationQuat4_14bit,
+          BiLinearRotationQuat4_7bit, BiLinearRotationQuatXW_14bit,
+          BiLinearRotationQuatYW_14bit, BiLinearRotationQuatZW_14bit,
+          BiLinearRotationQuat4_11bit, BiLinearRotationQuat4_9bit)
+
+#define LMTCODEC_VISIT(val)                                                    \
+  case TrackTypesShared::val:                                                  \
+    return visitor(static_cast<const Buff_EvalShared<Buf_##val> &>(ctr));
+
+// Calls visitor with controller cast to its Buff_EvalShared<C>.
+// Dispatches once per call, visitor can run templated loop over keys
+// without indirect calls.
+template <class F>
+decltype(auto) VisitCodec(const LMTTrackController &ctr, F &&visitor) {
+  switch (ctr.CodecType()) {
+    StaticFor(LMTCODEC_VISIT, SingleVector3, HermiteVector3,
+              StepRotationQuat3, SphericalRotation, LinearVector3,
+              BiLinearVector3_16bit, BiLinearVector3_8bit,
+              LinearRotationQuat4_14bit, BiLinearRotationQuat4_7bit,
+              BiLinearRotationQuatXW_14bit, BiLinearRotationQuatYW_14bit,
+              BiLinearRotationQuatZW_14bit, BiLinearRotationQuat4_11bit,
+              BiLinearRotationQuat4_9bit)
+  default:
+    throw es::RuntimeError("Invalid LMT codec type.");
+  }
+}
+
@@ -23,6 +23,7 @@
 #include "spike/uni/list_vector.hpp"
 #include "spike/util/endian.hpp"
 #include <memory>
+#include <span>
 #include <vector>
 
 using namespace revil;
@@ -58,6 +59,7 @@ enum class TrackTypesShared {
 };
 
 struct LMTTrackController {
+  virtual TrackTypesShared CodecType() const = 0;
   virtual size_t NumFrames() const = 0;
   virtual bool IsCubic() const = 0;
   virtual void GetTangents(Vector4A16 &inTangs, Vector4A16 &outTangs,
@@ -65,7 +67,13 @@ struct LMTTrackController {
   virtual void Evaluate(Vector4A16 &out, size_t frame) const = 0;
   virtual void Interpolate(Vector4A16 &out, size_t frame, float delta,
                            const TrackMinMax &bounds) const = 0;
+  // Batch Interpolate, frames must be sorted and below last key frame
+  virtual void InterpolateFrames(std::span<Vector4A16> out,
+                                 std::span<const float> frames,
+                                 const TrackMinMax &bounds) const = 0;
   virtual int32 GetFrame(size_t frameID) const = 0;
+  // Precomputed GetFrame for all keys, empty if not available
+  virtual std::span<const int16> Frames() const = 0;
   virtual void NumFrames(size_t numItems) = 0;
   virtual void ToString(std::string &strBuf, size_t numIdents) const = 0;
 
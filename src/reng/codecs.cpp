@@ -495,9 +495,87 @@ struct BiLinearSCQuat3_16bitController_old : BiLinearSCQuat3_16bitController {
   }
 };
 
+// Same as REMotionTrackWorker::GetValue for every time, but keys are walked
+// once and Evaluate is resolved statically
+template <class C> struct RETrackSampler final : C {
+  void Sample(std::span<Vector4A16> out, std::span<const float> times,
+              bool spherical) const override {
+    auto SampleFrames = [&](auto frames) {
+      using frame_type =
+          std::remove_cv_t<std::remove_pointer_t<decltype(frames)>>;
+      const uint32 numFrames = this->numFrames;
+      size_t offset = 0;
+      frame_type lastFrame = 0;
+
+      for (size_t i = 0; i < out.size(); i++) {
+        Vector4A16 &output = out[i];
+        output = Vector4A16{};
+
+        if (times[i] <= 0.0f || numFrames == 1) {
+          C::Evaluate(0, output);
+          continue;
+        }
+
+        float frameDelta = times[i] * 60.f;
+        const frame_type frame = static_cast<int32>(frameDelta);
+
+        if (frame < lastFrame) {
+          offset = 0;
+        }
+
+        lastFrame = frame;
+
+        while (offset < numFrames && frames[offset] < frame) {
+          offset++;
+        }
+
+        if (offset >= numFrames) {
+          C::Evaluate(numFrames - 1, output);
+          continue;
+        }
+
+        if (!offset) {
+          C::Evaluate(0, output);
+          continue;
+        }
+
+        const float fFrameBegin = static_cast<float>(frames[offset - 1]);
+        const float fFrameEnd = static_cast<float>(frames[offset]);
+
+        if (frames[offset - 1] == frames[offset]) {
+          frameDelta = 0.f;
+        } else {
+          frameDelta = (fFrameBegin - frameDelta) / (fFrameBegin - fFrameEnd);
+        }
+
+        C::Evaluate(offset - 1, output);
+
+        if (frameDelta > FLT_EPSILON) {
+          Vector4A16 nextValue;
+          C::Evaluate(offset, nextValue);
+
+          if (spherical) {
+            output = slerp(output, nextValue, frameDelta);
+          } else {
+            output = output + (nextValue - output) * frameDelta;
+          }
+        }
+      }
+    };
+
+    if (this->frameType == C::FrameType_short) {
+      SampleFrames(reinterpret_cast<const uint16 *>(this->frames));
+    } else {
+      SampleFrames(static_cast<const uint8 *>(this->frames));
+    }
+  }
+};
+
 using ptr_type_ = std::unique_ptr<RETrackController_internal>;
 
-template <class C> ptr_type_ controlDummy() { return std::make_unique<C>(); }
+template <class C> ptr_type_ controlDummy() {
+  return std::make_unique<RETrackSampler<C>>();
+}
 
 template <class C, size_t id> struct id_ {
   constexpr static auto get() { return C::ID; }
@@ -16,6 +16,7 @@
 */
 
 #include "motion_43.hpp"
+#include <algorithm>
 
 template <> void ProcessClass(REMotionBone &item, ProcessFlags flags) {
   es::FixupPointers(flags.base, *flags.ptrStore, item.boneName,
@@ -62,37 +63,6 @@ template <> void ProcessClass(REMotion43 &item, ProcessFlags flags) {
   }
 }
 
-// https://en.wikipedia.org/wiki/Slerp
-static Vector4A16 slerp(const Vector4A16 &v0, const Vector4A16 &_v1, float t) {
-  Vector4A16 v1 = _v1;
-  float dot = v0.Dot(v1);
-
-  // If the dot product is negative, slerp won't take
-  // the shorter path. Fix by reversing one quaternion.
-  if (dot < 0.0f) {
-    v1 *= -1;
-    dot *= -1;
-  }
-
-  static const float DOT_THRESHOLD = 0.9995f;
-  if (dot > DOT_THRESHOLD) {
-    // If the inputs are too close for comfort, linearly interpolate
-    // and normalize the result.
-
-    Vector4A16 result = v0 + (v1 - v0) * t;
-    return result.Normalize();
-  }
-
-  const float theta00 = acos(dot);   // theta00 = angle between input vectors
-  const float theta01 = theta00 * t; // theta01 = angle between v0 and result
-  const float theta02 = sin(theta01);
-  const float theta03 = 1.0f / sin(theta00);
-  const float s0 = cos(theta01) - dot * theta02 * theta03;
-  const float s1 = theta02 * theta03;
-
-  return (v0 * s0) + (v1 * s1);
-}
-
 void REMotionTrackWorker::GetValue(Vector4A16 &output, float time) const {
   // bugfix, some codecs will partialy apply elements, ensure we have identity
   output = Vector4A16{};
@@ -114,6 +84,12 @@ void REMotionTrackWorker::GetValue(Vector4A16 &output, float time) const {
     return;
   }
 
+  // Up to first key, same as RETrackSampler
+  if (!span.offset) {
+    controller->Evaluate(0, output);
+    return;
+  }
+
   const float fFrameBegin = static_cast<float>(span.first);
   const float fFrameEnd = static_cast<float>(span.second);
 
@@ -137,6 +113,18 @@ void REMotionTrackWorker::GetValue(Vector4A16 &output, float time) const {
   }
 }
 
+void REMotionTrackWorker::GetValues(std::span<Vector4A16> out,
+                                    std::span<const float> times) const {
+  out = out.first(std::min(out.size(), times.size()));
+
+  if (!controller) {
+    std::fill(out.begin(), out.end(), Vector4A16{});
+    return;
+  }
+
+  controller->Sample(out, times, cType == TrackType_e::Rotation);
+}
+
 void REMotion43Asset::Build() {
   const uint32 numTracks = Get().numTracks;
 
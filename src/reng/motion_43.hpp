@@ -17,6 +17,7 @@
 
 #pragma once
 #include "asset.hpp"
+#include "revil/re_asset.hpp"
 #include "spike/type/flags.hpp"
 #include "spike/type/vectors_simd.hpp"
 #include "spike/uni/list_vector.hpp"
@@ -47,6 +48,37 @@ struct KnotSpan {
   int32 second;
 };
 
+// https://en.wikipedia.org/wiki/Slerp
+inline Vector4A16 slerp(const Vector4A16 &v0, const Vector4A16 &_v1, float t) {
+  Vector4A16 v1 = _v1;
+  float dot = v0.Dot(v1);
+
+  // If the dot product is negative, slerp won't take
+  // the shorter path. Fix by reversing one quaternion.
+  if (dot < 0.0f) {
+    v1 *= -1;
+    dot *= -1;
+  }
+
+  static const float DOT_THRESHOLD = 0.9995f;
+  if (dot > DOT_THRESHOLD) {
+    // If the inputs are too close for comfort, linearly interpolate
+    // and normalize the result.
+
+    Vector4A16 result = v0 + (v1 - v0) * t;
+    return result.Normalize();
+  }
+
+  const float theta00 = acos(dot);   // theta00 = angle between input vectors
+  const float theta01 = theta00 * t; // theta01 = angle between v0 and result
+  const float theta02 = sin(theta01);
+  const float theta03 = 1.0f / sin(theta00);
+  const float s0 = cos(theta01) - dot * theta02 * theta03;
+  const float s1 = theta02 * theta03;
+
+  return (v0 * s0) + (v1 * s1);
+}
+
 struct RETrackController {
   using Ptr = std::unique_ptr<RETrackController>;
   virtual void Assign(RETrackCurve43 *iCurve) = 0;
@@ -55,6 +87,9 @@ struct RETrackController {
   virtual uint16 GetFrame(uint32 id) const = 0;
   virtual KnotSpan GetSpan(int32 frame) const = 0;
   virtual void Evaluate(uint32 id, Vector4A16 &out) const = 0;
+  // Batch of interpolated Evaluate calls for times sorted in ascending order
+  virtual void Sample(std::span<Vector4A16> out, std::span<const float> times,
+                      bool spherical) const = 0;
   virtual ~RETrackController() = default;
   virtual const char *CodecName() const = 0;
 };
@@ -98,9 +133,11 @@ template <class trackType> struct REMotion_t : public REAssetBase {
   uint16 unks00[2];
 };
 
-class REMotionTrackWorker : public uni::MotionTrack {
+class REMotionTrackWorker : public revil::REMotionTrack {
   TrackType_e TrackType() const override { return cType; }
   void GetValue(Vector4A16 &output, float time) const override;
+  void GetValues(std::span<Vector4A16> out,
+                 std::span<const float> times) const override;
   size_t BoneIndex() const override { return boneHash; }
 
 public:
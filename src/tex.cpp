@@ -22,6 +22,7 @@
 #include "spike/format/DDS.hpp"
 #include "spike/io/binreader_stream.hpp"
 #include <map>
+#include <optional>
 
 using namespace revil;
 
@@ -551,10 +552,10 @@ void revil::LoadDetectTex(BinReaderRef_e rd, Platform platform,
   rd.Read(header);
   rd.Seek(0);
 
-  std::stringstream backup;
+  std::optional<HFSStream> hfs;
   if (header.id == SFHID) {
-    backup = ProcessHFS(rd);
-    rd = BinReaderRef_e(backup);
+    hfs.emplace(rd);
+    rd = BinReaderRef_e(*hfs);
     rd.Push();
     rd.Read(header);
     rd.Pop();
@@ -0,0 +1,114 @@
+#pragma once
+#include "revil/hashreg.hpp"
+#include "spike/util/unit_testing.hpp"
+#include <string>
+#include <vector>
+
+// Original implementation, regenerates whole state for every character
+static uint32 MTHashV1Reference(std::string_view text) {
+  uint32 retVal = 0;
+  uint32 mtData[624];
+
+  auto makeSeed = [&](uint32 seed) {
+    mtData[0] = seed & 0xFFFF0000;
+    seed = 0x10DCD * seed + 1;
+    mtData[0] |= seed >> 16;
+
+    for (size_t i = 1; i < 624; i++) {
+      seed = 0x10DCD * seed + 1;
+      mtData[i] = seed & 0xFFFF0000;
+      seed = 0x10DCD * seed + 1;
+      mtData[i] |= seed >> 16;
+    }
+  };
+
+  for (size_t i = 0; i < text.size(); i++) {
+    auto nextChar = i + 1 == text.size() ? 0 : text[i + 1];
+    makeSeed((nextChar - 32) | ((text[i] - 32) << 6));
+    uint32 tmp0 = mtData[0] ^ ((mtData[0] ^ mtData[1]) & 0x7FFFFFFF);
+    uint32 tmp1 = mtData[397] ^ (0x9908B0DF * (tmp0 & 1)) ^ (tmp0 >> 1);
+    tmp1 ^= tmp1 >> 11;
+
+    retVal ^= (((((tmp1 & 0xFF3A58AD) << 7) ^ tmp1) & 0xFFFFDF8C) << 15) ^
+              ((tmp1 & 0xFF3A58AD) << 7) ^ tmp1 ^
+              (((((((tmp1 & 0xFF3A58AD) << 7) ^ tmp1) & 0xFFFFDF8C) << 15) ^
+                ((tmp1 & 0xFF3A58AD) << 7) ^ tmp1) >>
+               18);
+  }
+
+  return retVal & 0x7FFFFFFF;
+}
+
+int test_mthash_v1() {
+  static const std::string_view words[]{
+      "",
+      "a",
+      "rTexture",
+      "rModel",
+      "rMotionList",
+      "uCoord",
+      "cSoundRequest",
+      "MtFloat3",
+      "rScheduler",
+      "nDraw::DrawObject",
+      "~!@#$%^&*()_+",
+  };
+
+  for (auto w : words) {
+    TEST_EQUAL(revil::MTHashV1(w), MTHashV1Reference(w));
+  }
+
+  // Every character pair, including negative chars
+  char pair[2];
+
+  for (int c0 = 0; c0 < 0x100; c0++) {
+    for (int c1 = 0; c1 < 0x100; c1++) {
+      pair[0] = c0;
+      pair[1] = c1;
+      std::string_view text(pair, 2);
+      TEST_EQUAL(revil::MTHashV1(text), MTHashV1Reference(text));
+    }
+  }
+
+  return 0;
+}
+
+// Bitwise CRC32, without final xor
+static uint32 MTHashV2Reference(std::string_view text) {
+  uint32 crc = 0xFFFFFFFF;
+
+  for (uint8 c : text) {
+    crc ^= c;
+
+    for (size_t b = 0; b < 8; b++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+
+  return crc & 0x7FFFFFFF;
+}
+
+int test_mthash_v2() {
+  // Covers table, folding and mixed paths of all remainders
+  std::string buffer;
+  std::vector<std::string_view> texts;
+
+  for (size_t i = 0; i < 300; i++) {
+    buffer.push_back(char(i * 0x9E3779B1 >> 24));
+  }
+
+  for (size_t i = 0; i < buffer.size(); i++) {
+    std::string_view text(buffer.data(), i);
+    texts.push_back(text);
+    TEST_EQUAL(revil::MTHashV2(text), MTHashV2Reference(text));
+  }
+
+  std::vector<uint32> hashes(texts.size());
+  revil::MTHashV2(texts, hashes);
+
+  for (size_t i = 0; i < texts.size(); i++) {
+    TEST_EQUAL(hashes[i], MTHashV2Reference(texts[i]));
+  }
+
+  return 0;
+}
@@ -1,6 +1,10 @@
 #pragma once
 #include "spike/util/unit_testing.hpp"
+#include "mtf_lmt/bone_track.hpp"
 #include "mtf_lmt/codecs.hpp"
+#include <algorithm>
+#include <cstring>
+#include <random>
 
 // 90 -180 45
 static const Vector4A16 testingQuat(0.2706f, -0.2706f, -0.65328f, 0.65328f);
@@ -194,3 +198,288 @@ int test_lmt_codec12() {
 
   return 0;
 }
+
+// InterpolateFrames must be bit exact with Interpolate of every sample
+template <class C> int TestBulkRotations(TrackTypesShared type) {
+  static constexpr size_t numKeys = 45;
+  std::mt19937 rng(static_cast<uint32>(type));
+  // Padding for codecs reading whole uint64
+  std::vector<char> buffer(numKeys * sizeof(C) + 8);
+
+  for (auto &b : buffer) {
+    b = static_cast<char>(rng());
+  }
+
+  CTR control = CTR(LMTTrackController::CreateCodec(type));
+  control->Assign(buffer.data(), numKeys * sizeof(C), false);
+  const TrackMinMax bounds{
+      .min = Vector4A16(0.3f, -0.7f, 1.1f, 0.25f),
+      .max = Vector4A16(-0.1f, 0.5f, 0.9f, -2.0f),
+  };
+
+  std::span<const int16> keyFrames = control->Frames();
+  std::vector<float> sampleFrames;
+
+  for (size_t k = 0; k + 1 < keyFrames.size(); k++) {
+    if (keyFrames[k] < keyFrames[k + 1]) {
+      const float range = keyFrames[k + 1] - keyFrames[k];
+      sampleFrames.push_back(keyFrames[k]);
+      sampleFrames.push_back(keyFrames[k] + range * 0.37f);
+      sampleFrames.push_back(keyFrames[k] + range * 0.81f);
+    }
+  }
+
+  TEST_EQUAL(sampleFrames.empty(), false);
+
+  std::vector<Vector4A16> bulkValues(sampleFrames.size());
+  control->InterpolateFrames(bulkValues, sampleFrames, bounds);
+
+  for (size_t i = 0; i < sampleFrames.size(); i++) {
+    const float frame = sampleFrames[i];
+    size_t key = 0;
+
+    while (keyFrames[key + 1] <= static_cast<int32>(frame)) {
+      key++;
+    }
+
+    const float prevFrame = keyFrames[key];
+    const float delta = (prevFrame - frame) / (prevFrame - keyFrames[key + 1]);
+    Vector4A16 value;
+    control->Interpolate(value, key, delta, bounds);
+
+    TEST_EQUAL(memcmp(&value, &bulkValues[i], sizeof(Vector4A16)), 0);
+  }
+
+  return 0;
+}
+
+int test_lmt_bulk_rotations() {
+  TEST_EQUAL(TestBulkRotations<Buf_LinearRotationQuat4_14bit>(
+                 TrackTypesShared::LinearRotationQuat4_14bit),
+             0);
+  TEST_EQUAL(TestBulkRotations<Buf_BiLinearRotationQuat4_7bit>(
+                 TrackTypesShared::BiLinearRotationQuat4_7bit),
+             0);
+  TEST_EQUAL(TestBulkRotations<Buf_BiLinearRotationQuatXW_14bit>(
+                 TrackTypesShared::BiLinearRotationQuatXW_14bit),
+             0);
+  TEST_EQUAL(TestBulkRotations<Buf_BiLinearRotationQuatYW_14bit>(
+                 TrackTypesShared::BiLinearRotationQuatYW_14bit),
+             0);
+  TEST_EQUAL(TestBulkRotations<Buf_BiLinearRotationQuatZW_14bit>(
+                 TrackTypesShared::BiLinearRotationQuatZW_14bit),
+             0);
+  TEST_EQUAL(TestBulkRotations<Buf_BiLinearRotationQuat4_11bit>(
+                 TrackTypesShared::BiLinearRotationQuat4_11bit),
+             0);
+  TEST_EQUAL(TestBulkRotations<Buf_BiLinearRotationQuat4_9bit>(
+                 TrackTypesShared::BiLinearRotationQuat4_9bit),
+             0);
+
+  return 0;
+}
+
+int test_lmt_codec_visit() {
+  for (uint32 t = uint32(TrackTypesShared::SingleVector3);
+       t <= uint32(TrackTypesShared::BiLinearRotationQuat4_9bit); t++) {
+    const TrackTypesShared type = static_cast<TrackTypesShared>(t);
+    CTR control = CTR(LMTTrackController::CreateCodec(type));
+    control->NumFrames(1);
+
+    Vector4A16 resultVector;
+    control->Evaluate(resultVector, 0);
+    const Vector4A16 visitedVector = VisitCodec(*control, [](auto &codec) {
+      Vector4A16 retVal;
+      codec.Evaluate(retVal, 0);
+      return retVal;
+    });
+
+    TEST_EQUAL(uint32(control->CodecType()), t);
+    TEST_EQUAL(memcmp(&resultVector, &visitedVector, sizeof(Vector4A16)), 0);
+  }
+
+  return 0;
+}
+
+struct TestLMTTrack : LMTTrackInterface {
+  Vector4A16 refData = testingQuatBi;
+  std::vector<char> buffer;
+
+  // Random keys of codec with precomputed key frames
+  explicit TestLMTTrack(uint32 seed) {
+    static constexpr size_t numKeys = 45;
+    std::mt19937 rng(seed);
+    // Padding for codecs reading whole uint64
+    buffer.resize(numKeys * sizeof(Buf_LinearRotationQuat4_14bit) + 8);
+
+    for (auto &b : buffer) {
+      b = static_cast<char>(rng());
+    }
+
+    controller = CTR(LMTTrackController::CreateCodec(
+        TrackTypesShared::LinearRotationQuat4_14bit));
+    controller->Assign(buffer.data(),
+                       numKeys * sizeof(Buf_LinearRotationQuat4_14bit), false);
+  }
+
+  TrackType_e GetTrackType() const override { return TrackType_LocalRotation; }
+  size_t Stride() const override { return 0; }
+  size_t BoneIndex() const override { return 0; }
+  uint32 BoneType() const override { return 0; }
+  const Vector4A16 GetRefData() const override { return refData; }
+  bool UseTrackExtremes() const override { return false; }
+  std::string_view CompressionType() const override { return {}; }
+
+  // Sampling without cursor, keys are scanned linearly
+  void LinearScanValue(Vector4A16 &out, float time) const {
+    float frameDelta = time * frameRate;
+    int32 frame = static_cast<int32>(frameDelta);
+    const size_t numCtrFrames = controller->NumFrames();
+
+    if (useRefFrame && loopFrame < 1) {
+      if (!frame) {
+        if (frameDelta < 0.0001f) {
+          out = GetRefData();
+        } else {
+          frameDelta -= frame;
+          Evaluate(out, 0);
+          out = GetRefData() + (out - GetRefData()) * frameDelta;
+        }
+
+        return;
+      }
+
+      frame--;
+      frameDelta -= 1.f;
+    }
+
+    const int32 maxFrame = controller->GetFrame(numCtrFrames - 1);
+
+    if (frame >= maxFrame) {
+      Evaluate(out, numCtrFrames - 1);
+      return;
+    }
+
+    for (size_t f = 1; f < numCtrFrames; f++) {
+      const int32 cFrame = controller->GetFrame(f);
+
+      if (cFrame > frame) {
+        const float boundFrame = static_cast<float>(cFrame);
+        const float prevFrame = static_cast<float>(controller->GetFrame(f - 1));
+        frameDelta = (prevFrame - frameDelta) / (prevFrame - boundFrame);
+        controller->Interpolate(out, f - 1, frameDelta, minMax);
+        return;
+      }
+    }
+  }
+
+  // Times from 0 over last key frame, with reference frame offset
+  std::vector<float> SampleTimes(float frameStep) const {
+    const int32 maxFrame = controller->GetFrame(controller->NumFrames() - 1);
+    std::vector<float> times;
+
+    for (float f = 0; f < maxFrame + 4; f += frameStep) {
+      times.push_back(f / frameRate);
+    }
+
+    return times;
+  }
+};
+
+// Cursor sampling must be bit exact with linear key scan in any order
+static int TestCursorSampling(const TestLMTTrack &track,
+                              std::span<const float> times) {
+  LMTTrackCursor cursor;
+
+  for (float t : times) {
+    Vector4A16 value;
+    Vector4A16 expected;
+    track.GetValue(value, t, cursor);
+    track.LinearScanValue(expected, t);
+
+    TEST_EQUAL(memcmp(&value, &expected, sizeof(Vector4A16)), 0);
+  }
+
+  return 0;
+}
+
+int test_lmt_track_cursor() {
+  TestLMTTrack track(0x22);
+  std::vector<float> times = track.SampleTimes(0.37f);
+
+  // Monotonic
+  TEST_EQUAL(TestCursorSampling(track, times), 0);
+
+  // Backward seek, cursor stays at last key
+  std::vector<float> backwardTimes(times.rbegin(), times.rend());
+  TEST_EQUAL(TestCursorSampling(track, backwardTimes), 0);
+
+  // Random access
+  std::vector<float> randomTimes = times;
+  std::shuffle(randomTimes.begin(), randomTimes.end(), std::mt19937(0x22));
+  TEST_EQUAL(TestCursorSampling(track, randomTimes), 0);
+
+  // Exact key frames, shifted by reference frame
+  std::vector<float> keyTimes;
+
+  for (size_t k = 0; k < track.NumFrames(); k++) {
+    keyTimes.push_back((track.GetFrame(k) + 1) / track.frameRate);
+  }
+
+  TEST_EQUAL(TestCursorSampling(track, keyTimes), 0);
+
+  // Same without reference frame
+  track.useRefFrame = 0;
+  TEST_EQUAL(TestCursorSampling(track, times), 0);
+  keyTimes.clear();
+
+  for (size_t k = 0; k < track.NumFrames(); k++) {
+    keyTimes.push_back(track.GetFrame(k) / track.frameRate);
+  }
+
+  TEST_EQUAL(TestCursorSampling(track, keyTimes), 0);
+
+  return 0;
+}
+
+// Batch sampling must match per sample GetValue, including reference frame
+// and samples past last key
+static int TestBatchSampling(const TestLMTTrack &track,
+                             std::span<const float> times) {
+  std::vector<Vector4A16> values(times.size());
+  track.GetValues(values, times);
+  Vector4A16::SetEpsilon(0.00001f);
+
+  for (size_t i = 0; i < times.size(); i++) {
+    Vector4A16 expected;
+    track.GetValue(expected, times[i]);
+
+    TEST_EQUAL(expected, values[i]);
+  }
+
+  return 0;
+}
+
+int test_lmt_track_batch() {
+  TestLMTTrack track(0x23);
+  const std::vector<float> times = track.SampleTimes(0.29f);
+
+  TEST_EQUAL(TestBatchSampling(track, times), 0);
+
+  // Shorter output samples only its size
+  std::vector<Vector4A16> values(times.size() / 2);
+  track.GetValues(values, times);
+  Vector4A16 expected;
+  track.GetValue(expected, times[values.size() - 1]);
+  TEST_EQUAL(expected, values.back());
+
+  // Looped animation has no reference frame
+  track.loopFrame = 10;
+  TEST_EQUAL(TestBatchSampling(track, times), 0);
+
+  track.loopFrame = -1;
+  track.useRefFrame = 0;
+  TEST_EQUAL(TestBatchSampling(track, times), 0);
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "reng/motion_43.hpp"
+#include "spike/util/unit_testing.hpp"
+#include <cstring>
+
+// Curve with its data, pointers are stored as offsets like in file
+template <class F, size_t N> struct RETestCurve {
+  RETrackCurve43 curve;
+  F frames[N];
+  Vector points[N];
+
+  RETestCurve(uint32 codec, const F (&frames_)[N]) {
+    memset(static_cast<void *>(this), 0, sizeof(*this));
+    const uint32 frameType = sizeof(F) == 2 ? 4 : 2;
+    curve.flags = codec | (frameType << 20);
+    curve.numFrames = N;
+    memcpy(frames, frames_, sizeof(frames));
+
+    for (size_t i = 0; i < N; i++) {
+      points[i] = Vector(0.1f * i, 0.3f - 0.05f * i, 0.02f * i * i);
+    }
+
+    char *base = reinterpret_cast<char *>(this);
+    const uint64 framesOffset = reinterpret_cast<char *>(frames) - base;
+    const uint64 pointsOffset = reinterpret_cast<char *>(points) - base;
+    memcpy(static_cast<void *>(&curve.frames), &framesOffset, 8);
+    memcpy(static_cast<void *>(&curve.controlPoints), &pointsOffset, 8);
+    std::vector<void *> ptrStore;
+    es::FixupPointers(base, ptrStore, curve.frames, curve.controlPoints,
+                      curve.minMaxBounds);
+  }
+
+  RETestCurve(const RETestCurve &) = delete;
+};
+
+// GetValues must match GetValue of every time
+template <class F, size_t N>
+int TestRETrackSampling(uint32 codec, uni::MotionTrack::TrackType_e type,
+                        const F (&frames)[N]) {
+  RETestCurve<F, N> data(codec, frames);
+  REMotionTrackWorker worker;
+  worker.controller = data.curve.GetController();
+  worker.cType = type;
+  worker.numFrames = N;
+  const revil::REMotionTrack &track = worker;
+
+  TEST_EQUAL(bool(worker.controller), true);
+
+  std::vector<float> times;
+
+  for (float f = 0; f < frames[N - 1] + 5; f += 0.41f) {
+    times.push_back(f / 60.f);
+  }
+
+  std::vector<Vector4A16> values(times.size());
+  track.GetValues(values, times);
+
+  Vector4A16 firstKey{};
+  worker.controller->Evaluate(0, firstKey);
+  Vector4A16::SetEpsilon(0.00001f);
+
+  for (size_t i = 0; i < times.size(); i++) {
+    Vector4A16 expected;
+    track.GetValue(expected, times[i]);
+
+    TEST_EQUAL(expected, values[i]);
+
+    // Samples up to first key evaluate key 0
+    if (static_cast<int32>(times[i] * 60.f) <= frames[0]) {
+      TEST_EQUAL(firstKey, values[i]);
+    }
+  }
+
+  return 0;
+}
+
+int test_re_track_sampling() {
+  static constexpr uint32 LINEAR_VECTOR3 = 0xF2;
+  static constexpr uint32 LINEAR_QUAT3 = 0xB0112;
+  const uint8 frames8[]{3, 5, 9, 9, 14, 30};
+  const uint16 frames16[]{3, 40, 300, 300, 700, 1000};
+
+  TEST_EQUAL(TestRETrackSampling(LINEAR_VECTOR3, uni::MotionTrack::Position,
+                                 frames8),
+             0);
+  TEST_EQUAL(TestRETrackSampling(LINEAR_VECTOR3, uni::MotionTrack::Position,
+                                 frames16),
+             0);
+  TEST_EQUAL(TestRETrackSampling(LINEAR_QUAT3, uni::MotionTrack::Rotation,
+                                 frames8),
+             0);
+  TEST_EQUAL(TestRETrackSampling(LINEAR_QUAT3, uni::MotionTrack::Rotation,
+                                 frames16),
+             0);
+
+  return 0;
+}
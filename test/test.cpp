@@ -1,5 +1,7 @@
 
+#include "hash.inl"
 #include "lmt_codecs.inl"
+#include "re_tracks.inl"
 
 int main() {
   es::print::AddPrinterFunction(es::Print);
@@ -10,7 +12,13 @@ int main() {
              TEST_FUNC(test_lmt_codec05), TEST_FUNC(test_lmt_codec06),
              TEST_FUNC(test_lmt_codec07), TEST_FUNC(test_lmt_codec08),
              TEST_FUNC(test_lmt_codec09), TEST_FUNC(test_lmt_codec10),
-             TEST_FUNC(test_lmt_codec11), TEST_FUNC(test_lmt_codec12));
+             TEST_FUNC(test_lmt_codec11), TEST_FUNC(test_lmt_codec12),
+             TEST_FUNC(test_lmt_bulk_rotations),
+             TEST_FUNC(test_lmt_codec_visit),
+             TEST_FUNC(test_lmt_track_cursor),
+             TEST_FUNC(test_lmt_track_batch),
+             TEST_FUNC(test_re_track_sampling),
+             TEST_FUNC(test_mthash_v1), TEST_FUNC(test_mthash_v2));
 
   return testResult;
 }
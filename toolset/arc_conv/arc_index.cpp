@@ -0,0 +1,74 @@
+/*  ARCConvert
+    Copyright(C) 2026 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "arc_conv.hpp"
+#include "project.h"
+#include "revil/arc_index.hpp"
+#include "spike/master_printer.hpp"
+
+static struct ARCIndex : ReflectorBase<ARCIndex> {
+  std::string title;
+  Platform platform = Platform::Auto;
+} settings;
+
+REFLECT(CLASS(ARCIndex),
+        MEMBER(title, "t", ReflDesc{"Set title for correct archive handling."}),
+        MEMBER(platform, "p",
+               ReflDesc{"Set platform for correct archive handling."}));
+
+std::string_view filters[]{
+    ".arc$",
+};
+
+static AppInfo_s appInfo{
+    .filteredLoad = true,
+    .header = ARCConvert_DESC " v" ARCConvert_VERSION ", " ARCConvert_COPYRIGHT
+                              "Lukas Cone",
+    .settings = reinterpret_cast<ReflectorFriend *>(&settings),
+    .filters = filters,
+};
+
+AppInfo_s *AppInitModule() { return &appInfo; }
+
+struct ArcIndexContext : AppPackContext {
+  std::string indexPath;
+  std::string folder;
+
+  ArcIndexContext(const std::string &indexPath_, const std::string &folder_)
+      : indexPath(indexPath_), folder(folder_) {}
+
+  // Archives are scanned by ArcIndex::Build itself
+  void SendFile(std::string_view, std::istream &) override {}
+
+  void Finish() override {
+    const size_t numParsed = revil::ArcIndex::Build(
+        indexPath, folder, settings.platform, settings.title);
+    revil::ArcIndex index(indexPath);
+    printline("Indexed " << index.Entries().size() << " entries from "
+                         << index.NumArchives() << " archives, parsed "
+                         << numParsed << " archives.");
+  }
+};
+
+AppPackContext *AppNewArchive(const std::string &folder) {
+  auto file = folder;
+  while (file.back() == '/') {
+    file.pop_back();
+  }
+
+  return new ArcIndexContext(file + ".arcidx", folder);
+}
@@ -24,7 +24,12 @@ static struct ARCExtract : ReflectorBase<ARCExtract> {
   std::string title;
   Platform platform = Platform::Auto;
   std::string classWhitelist;
+  uint32 numThreads = 1;
+  uint32 memoryBudget = 256;
+  std::string includePaths;
+  std::string excludePaths;
   std::set<uint32> classWhitelist_;
+  revil::ArcPathFilter pathFilter_;
 } settings;
 
 REFLECT(CLASS(ARCExtract),
@@ -33,7 +38,21 @@ REFLECT(CLASS(ARCExtract),
                ReflDesc{"Set platform for correct archive handling."}),
         MEMBERNAME(classWhitelist, "class-whitelist",
                    ReflDesc{"Extract only specified (comma separated) classes. "
-                            "Extract all if empty."}));
+                            "Extract all if empty."}),
+        MEMBERNAME(numThreads, "threads",
+                   ReflDesc{"Number of decompression threads per archive. "
+                            "0 = use all cores."}),
+        MEMBERNAME(memoryBudget, "memory-budget",
+                   ReflDesc{"Maximum size of buffered entries in MB, when "
+                            "decompressing with multiple threads."}),
+        MEMBERNAME(includePaths, "include-paths",
+                   ReflDesc{"Extract only paths matching specified (comma "
+                            "separated) patterns. Paths include extension, "
+                            "supports * ** and ? wildcards, folder matches "
+                            "its whole subtree. Extract all if empty."}),
+        MEMBERNAME(excludePaths, "exclude-paths",
+                   ReflDesc{"Skip paths matching specified (comma separated) "
+                            "patterns."}));
 
 std::string_view filters[]{
     ".arc$",
@@ -50,31 +69,38 @@ static AppInfo_s appInfo{
 AppInfo_s *AppInitModule() { return &appInfo; }
 
 bool AppInitContext(const std::string &) {
-  std::string_view sv(settings.classWhitelist);
-  size_t lastPost = 0;
-  auto found = sv.find(',');
-
-  while (found != sv.npos) {
-    auto sub = sv.substr(lastPost, found - lastPost);
-    settings.classWhitelist_.insert(revil::MTHashV1(es::TrimWhitespace(sub)));
-    settings.classWhitelist_.insert(revil::MTHashV2(es::TrimWhitespace(sub)));
-    lastPost = ++found;
-    found = sv.find(',', lastPost);
-  }
-
-  if (lastPost < sv.size()) {
-    std::string_view sub = sv.substr(lastPost);
-    settings.classWhitelist_.insert(revil::MTHashV1(es::TrimWhitespace(sub)));
-    settings.classWhitelist_.insert(revil::MTHashV2(es::TrimWhitespace(sub)));
-  }
+  SplitList(settings.classWhitelist, [](std::string_view sub) {
+    settings.classWhitelist_.insert(revil::MTHashV1(sub));
+    settings.classWhitelist_.insert(revil::MTHashV2(sub));
+  });
+
+  auto AddPatterns = [](std::string_view list,
+                        std::vector<std::string> &patterns) {
+    SplitList(list, [&](std::string_view sub) {
+      if (!sub.empty()) {
+        patterns.emplace_back(sub);
+      }
+    });
+  };
+
+  AddPatterns(settings.includePaths, settings.pathFilter_.include);
+  AddPatterns(settings.excludePaths, settings.pathFilter_.exclude);
 
   return true;
 }
 
 void AppProcessFile(AppContext *ctx) {
+  revil::ArcEnumerateSettings enumSettings{
+      .numThreads = settings.numThreads,
+      .memoryBudget = size_t(settings.memoryBudget) << 20,
+      .order = revil::ArcOutputOrder::Completion,
+      .pathFilter = settings.pathFilter_,
+  };
+
   revil::EnumerateArchive(
       ctx->GetStream(), settings.platform, settings.title,
-      [ctx] { return ctx->ExtractContext(); }, settings.classWhitelist_);
+      [ctx] { return ctx->ExtractContext(); }, settings.classWhitelist_, false,
+      enumSettings);
 }
 
 size_t AppExtractStat(request_chunk requester) {
@@ -18,25 +18,51 @@
 #include "arc_conv.hpp"
 #include "project.h"
 #include "revil/arc.hpp"
+#include "revil/decompressor.hpp"
 #include "spike/format/WAVE.hpp"
 #include "spike/io/binreader.hpp"
 #include "spike/io/binwritter.hpp"
-#include "spike/io/stat.hpp"
+#include "spike/io/directory_scanner.hpp"
 #include "spike/master_printer.hpp"
 #include <algorithm>
-#include <atomic>
+#include <filesystem>
+#include <future>
+#include <map>
 #include <mutex>
-#include <thread>
+#include <optional>
+#include <set>
 
 static struct ARCMake : ReflectorBase<ARCMake> {
   std::string title;
   Platform platform = Platform::Auto;
+  uint32 compressionLevel = 9;
+  uint32 probeSize = 64;
+  bool deduplicate = true;
+  bool contentHashes = true;
+  std::string baseArchive;
 } settings;
 
 REFLECT(CLASS(ARCMake),
         MEMBER(title, "t", ReflDesc{"Set title for correct archive handling."}),
         MEMBER(platform, "p",
-               ReflDesc{"Set platform for correct archive handling."}));
+               ReflDesc{"Set platform for correct archive handling."}),
+        MEMBERNAME(compressionLevel, "compression-level",
+                   ReflDesc{"Deflate level 1-9."}),
+        MEMBERNAME(probeSize, "probe-size",
+                   ReflDesc{"Size of samples in KB that are quickly compressed "
+                            "to estimate ratio before full compression. "
+                            "0 = disable."}),
+        MEMBERNAME(deduplicate, "deduplicate",
+                   ReflDesc{"Store identical files only once, their TOC "
+                            "entries will point to the same data."}),
+        MEMBERNAME(contentHashes, "content-hashes",
+                   ReflDesc{"Write content hashes of entries into "
+                            "<archive>.hashes, update mode uses them to "
+                            "detect unchanged files without decompression."}),
+        MEMBERNAME(baseArchive, "base-archive",
+                   ReflDesc{"Update mode. Entries of this archive are copied "
+                            "without recompression, unless folder contains "
+                            "a modified file with the same path."}));
 
 static AppInfo_s appInfo{
     .header = ARCConvert_DESC " v" ARCConvert_VERSION ", " ARCConvert_COPYRIGHT
@@ -47,47 +73,225 @@ static AppInfo_s appInfo{
 
 AppInfo_s *AppInitModule() { return &appInfo; }
 
+// Extra ratio tolerance of level 1 probe over real compression level
+static constexpr uint32 PROBE_MARGIN = 5;
+static constexpr size_t NUM_PROBE_SAMPLES = 4;
+
+// Compress evenly spaced samples at level 1
+// Returns estimated ratio in percent or 0 if data are too small for probing
+static uint32 EstimateRatio(std::string_view data, int windowSize) {
+  const size_t probeSize = size_t(settings.probeSize) << 10;
+
+  if (!probeSize || data.size() <= probeSize * 2) {
+    return 0;
+  }
+
+  const size_t sampleSize = probeSize / NUM_PROBE_SAMPLES;
+  const size_t sampleStride =
+      (data.size() - sampleSize) / (NUM_PROBE_SAMPLES - 1);
+  std::string samples;
+  samples.reserve(sampleSize * NUM_PROBE_SAMPLES);
+
+  for (size_t s = 0; s < NUM_PROBE_SAMPLES; s++) {
+    samples.append(data.substr(s * sampleStride, sampleSize));
+  }
+
+  std::string outBuffer;
+  outBuffer.resize(std::max(samples.size() + 0x100, size_t(0x8000)));
+  const size_t compressedSize =
+      revil::CompressZlib(samples, outBuffer, windowSize, 1);
+
+  return std::max(((float)compressedSize / (float)samples.size()) * 100, 1.f);
+}
+
+// Two independent 64 bit hashes of uncompressed data
+struct AContentHash {
+  uint64 hash0 = 0xCBF29CE484222325;
+  uint64 hash1 = 0;
+
+  AContentHash() = default;
+  AContentHash(std::string_view data) : hash1(data.size()) {
+    for (uint8 c : data) {
+      hash0 = (hash0 ^ c) * 0x100000001B3;
+    }
+
+    size_t i = 0;
+
+    for (; i + 8 <= data.size(); i += 8) {
+      uint64 word;
+      memcpy(&word, data.data() + i, 8);
+      Mix(word);
+    }
+
+    for (; i < data.size(); i++) {
+      Mix(uint8(data[i]));
+    }
+  }
+
+  void Mix(uint64 value) {
+    hash1 = (hash1 ^ value) * 0xFF51AFD7ED558CCD;
+    hash1 ^= hash1 >> 32;
+  }
+
+  bool operator==(const AContentHash &) const = default;
+};
+
+// <archive>.hashes, entries are in TOC order
+struct AHashesHeader {
+  static constexpr uint32 ID = CompileFourCC("ARCH");
+  static constexpr uint32 VERSION = 1;
+  uint32 id = ID;
+  uint32 version = VERSION;
+  uint64 archiveSize;
+  int64 archiveModTime;
+  uint32 numEntries;
+  uint32 null = 0;
+};
+
+struct AHashesEntry {
+  AContentHash contentHash;
+  uint32 uSize;
+  uint32 valid;
+};
+
 struct AFile {
   std::string path;
   size_t offset;
   uint32 hash;
   uint32 uSize;
   uint32 cSize;
+  AContentHash contentHash;
+  bool hasContentHash = false;
 };
 
-struct Stream {
-  std::string streamPath;
-  BinWritter_t<BinCoreOpenMode::NoBuffer> streamStore;
-  std::vector<AFile> files;
+struct ABlob {
+  size_t offset;
+  uint32 cSize;
+  bool stored;
+};
+
+// Size and hash of uncompressed data, used only as a bucket.
+// Blobs with the same key are byte compared before reuse.
+struct ABlobKey {
+  size_t size;
+  size_t hash;
+
+  ABlobKey(std::string_view data)
+      : size(data.size()), hash(std::hash<std::string_view>{}(data)) {}
 
-  Stream(std::string &&path)
-      : streamPath(std::move(path)), streamStore(streamPath) {}
+  auto operator<=>(const ABlobKey &) const = default;
 };
 
+// Header and TOC are reserved up front for maxFiles entries, compressed
+// data is appended right after and TOC is patched in Finish.
+// Offsets are absolute, TOC slots of skipped files are left as zero padding.
 struct ArcMakeContext : AppPackContext {
-  std::string outArc;
-  std::map<std::thread::id, Stream> streams;
+  std::string outPath;
+  BinWritter_t<BinCoreOpenMode::NoBuffer> wr;
+  std::mutex writeMutex;
+  std::vector<AFile> files;
+  std::multimap<ABlobKey, std::shared_future<ABlob>> blobs;
   const TitleSupport *ts;
-  static inline std::atomic_uint32_t numFiles; // fugly
-
-  Stream &NewStream() {
-    static std::mutex streamsMutex;
-    auto thisId = std::this_thread::get_id();
-    uint32 threadId = reinterpret_cast<uint32 &>(thisId);
-    std::string path = outArc + std::to_string(threadId) + ".data";
-
-    {
-      std::lock_guard<std::mutex> lg(streamsMutex);
-      streams.emplace(thisId, std::move(path));
-      return streams.at(thisId);
+  revil::TitleContext titleCtx;
+  size_t maxFiles;
+  std::unique_ptr<revil::ArcReader> base;
+  std::vector<AHashesEntry> baseHashes;
+  std::set<const revil::ArcEntry *> usedBaseEntries;
+
+  size_t HeaderSize() const {
+    if (ts->arc.version < 10 || (ts->arc.flags & revil::DbArc_XMemCompress)) {
+      return sizeof(ARCBase);
+    }
+
+    return sizeof(ARC);
+  }
+
+  size_t TocEntrySize() const {
+    return (ts->arc.flags & revil::DbArc_ExtendedPath) ? sizeof(ARCExtendedFile)
+                                                        : sizeof(ARCFile);
+  }
+
+  ArcMakeContext(const std::string &path, size_t maxFiles_,
+                 std::unique_ptr<revil::ArcReader> base_,
+                 std::vector<AHashesEntry> baseHashes_)
+      : outPath(path), wr(path),
+        ts(revil::GetTitleSupport(settings.title, settings.platform)),
+        titleCtx(settings.title, settings.platform),
+        maxFiles(std::min(
+            maxFiles_,
+            size_t(std::numeric_limits<decltype(ARC::numFiles)>::max()))),
+        base(std::move(base_)), baseHashes(std::move(baseHashes_)) {
+    const std::string reserved(HeaderSize() + maxFiles * TocEntrySize(), 0);
+    wr.WriteBuffer(reserved.data(), reserved.size());
+  }
+
+  // Caller must hold writeMutex
+  void AddFile(AFile &&file) {
+    if (files.size() >= maxFiles) {
+      if (maxFiles == std::numeric_limits<decltype(ARC::numFiles)>::max()) {
+        throw es::RuntimeError("Filecount exceeded archive limit.");
+      }
+
+      throw es::RuntimeError("Filecount exceeded reserved TOC size.");
+    }
+
+    files.emplace_back(std::move(file));
+  }
+
+  // Compare data with blob already written into output
+  bool IsBlobData(const ABlob &blob, std::string_view data) const {
+    std::string blobData(blob.cSize, 0);
+    BinReader_t<BinCoreOpenMode::NoBuffer> rd(outPath);
+    rd.Seek(blob.offset);
+    rd.ReadBuffer(&blobData[0], blob.cSize);
+
+    if (blob.stored) {
+      return blobData == data;
+    }
+
+    auto &decomp = revil::Decompressor::ThreadLocal();
+    std::string &outBuffer = decomp.OutputBuffer(data.size());
+    const size_t outSize =
+        decomp.Decompress(revil::CompressionType::Zlib, blobData, outBuffer,
+                          data.size());
+
+    return outSize == data.size() &&
+           !memcmp(outBuffer.data(), data.data(), data.size());
+  }
+
+  // Sizes first, then raw data of stored entry or content hash.
+  // Base entry is decompressed only if it has no content hash.
+  bool IsBaseData(const revil::ArcEntry &entry, std::string_view data,
+                  const AContentHash &contentHash) const {
+    if (entry.uncompressedSize != data.size()) {
+      return false;
+    }
+
+    if (entry.isStored) {
+      return base->ReadRaw(entry) == data;
     }
+
+    if (!baseHashes.empty()) {
+      auto &baseHash = baseHashes.at(&entry - base->Entries().data());
+
+      if (baseHash.valid && baseHash.uSize == data.size()) {
+        return baseHash.contentHash == contentHash;
+      }
+    }
+
+    std::string baseBuffer;
+    return base->Get(entry, baseBuffer) == data;
   }
 
-  ArcMakeContext() = default;
-  ArcMakeContext(const std::string &path)
-      : outArc(path),
-        ts(revil::GetTitleSupport(settings.title, settings.platform)) {}
-  ArcMakeContext &operator=(ArcMakeContext &&) = default;
+  // Copy compressed data of base archive entry as they are
+  void CopyBaseEntry(const revil::ArcEntry &entry, AFile &&file) {
+    const std::string data = base->ReadRaw(entry);
+    std::lock_guard<std::mutex> lg(writeMutex);
+    file.offset = wr.Tell();
+    file.cSize = entry.compressedSize;
+    AddFile(std::move(file));
+    wr.WriteBuffer(data.data(), data.size());
+  }
 
   void SendFile(std::string_view path, std::istream &stream) override {
     const size_t extPos = path.find_last_of('.');
@@ -98,7 +302,7 @@ struct ArcMakeContext : AppPackContext {
     }
 
     auto extension = path.substr(extPos + 1);
-    auto hashes = GetHash(extension, settings.title, settings.platform);
+    auto hashes = titleCtx.GetHash(extension);
 
     if (hashes.empty()) {
       printwarning("Skipped (invalid format): " << path);
@@ -126,14 +330,13 @@ struct ArcMakeContext : AppPackContext {
             hash = revil::MTHashV2("rSoundSourceSeAT9");
           }
 
-          hashes.clear();
+          hashes = {};
         }
       }
 
       if (hashes.size() > 1) {
         for (auto &h : hashes) {
-          if (revil::GetExtension(h, settings.title, settings.platform) ==
-              extension) {
+          if (titleCtx.GetExtension(h) == extension) {
             if (hash) {
               printwarning(
                   "Skipped (multiple classes from extension): " << path);
@@ -157,12 +360,6 @@ struct ArcMakeContext : AppPackContext {
       return;
     }
 
-    numFiles++;
-
-    if (numFiles > std::numeric_limits<decltype(ARC::numFiles)>::max()) {
-      throw es::RuntimeError("Filecount exceeded archive limit.");
-    }
-
     stream.seekg(0, std::ios::end);
     const size_t streamSize = stream.tellg();
     stream.seekg(0);
@@ -175,18 +372,7 @@ struct ArcMakeContext : AppPackContext {
       return revil::CompressZlib(buffer, outBuffer, ts->arc.windowSize, cType);
     };
 
-    auto found = streams.find(std::this_thread::get_id());
-    Stream *tStream = nullptr;
-
-    if (es::IsEnd(streams, found)) {
-      tStream = &NewStream();
-    } else {
-      tStream = &found->second;
-    }
-
-    auto &streamStore = tStream->streamStore;
     AFile curFile;
-    curFile.offset = streamStore.Tell();
     curFile.hash = hash;
     curFile.uSize = streamSize;
     curFile.path = noExt;
@@ -208,17 +394,109 @@ struct ArcMakeContext : AppPackContext {
       processed = true;
     }
 
-    if (!processed && streamSize > minFileSize) {
-      compressedSize = CompressData(buffer, 9);
+    curFile.contentHash = AContentHash(processed ? outBuffer : buffer);
+    curFile.hasContentHash = true;
+
+    if (base) {
+      if (auto baseEntry = base->Find(path); baseEntry) {
+        {
+          std::lock_guard<std::mutex> lg(writeMutex);
+          usedBaseEntries.insert(baseEntry);
+        }
+
+        if (IsBaseData(*baseEntry, processed ? outBuffer : buffer,
+                       curFile.contentHash)) {
+          CopyBaseEntry(*baseEntry, std::move(curFile));
+          return;
+        }
+      }
+    }
+
+    std::promise<ABlob> blobPromise;
+    bool ownsBlob = false;
+
+    if (settings.deduplicate) {
+      const std::string_view data(processed ? outBuffer : buffer);
+      const ABlobKey key(data);
+      std::vector<std::shared_future<ABlob>> candidates;
+      decltype(blobs)::iterator ownBlob;
+
+      {
+        std::lock_guard<std::mutex> lg(writeMutex);
+        auto [begin, end] = blobs.equal_range(key);
+
+        for (; begin != end; begin++) {
+          candidates.push_back(begin->second);
+        }
+
+        ownBlob = blobs.emplace(key, blobPromise.get_future().share());
+        ownsBlob = true;
+      }
 
-      uint32 ratio = ((float)compressedSize / (float)streamSize) * 100;
+      std::optional<ABlob> sameBlob;
 
-      if (ratio <= ratioThreshold) {
-        processed = true;
+      try {
+        for (auto &c : candidates) {
+          // Same data might still be compressed by other thread
+          if (const ABlob blob = c.get(); IsBlobData(blob, data)) {
+            sameBlob = blob;
+            break;
+          }
+        }
+      } catch (...) {
+        blobPromise.set_exception(std::current_exception());
+        throw;
+      }
+
+      if (sameBlob) {
+        blobPromise.set_value(*sameBlob);
+        std::lock_guard<std::mutex> lg(writeMutex);
+        blobs.erase(ownBlob);
+        curFile.offset = sameBlob->offset;
+        curFile.cSize = sameBlob->cSize;
+
+        if (verbosityLevel) {
+          printline("Deduplicated " << path);
+        }
+
+        AddFile(std::move(curFile));
+        return;
       }
     }
 
-    [&] {
+    auto StoreData = [&] {
+      if (!processed && streamSize > minFileSize) {
+        const uint32 estimatedRatio =
+            EstimateRatio(buffer, ts->arc.windowSize);
+
+        if (estimatedRatio > ratioThreshold + PROBE_MARGIN) {
+          if (verbosityLevel) {
+            printline("Probe fail " << estimatedRatio << "%% for " << path);
+          }
+        } else {
+          compressedSize = CompressData(
+              buffer, std::clamp(settings.compressionLevel, 1U, 9U));
+
+          uint32 ratio = ((float)compressedSize / (float)streamSize) * 100;
+
+          if (ratio <= ratioThreshold) {
+            processed = true;
+          }
+        }
+      }
+
+      auto WriteData = [&](const std::string &data, bool stored) {
+        std::lock_guard<std::mutex> lg(writeMutex);
+        curFile.offset = wr.Tell();
+        curFile.cSize = compressedSize;
+        AddFile(AFile(curFile));
+        wr.WriteBuffer(data.data(), compressedSize);
+
+        if (ownsBlob) {
+          blobPromise.set_value({curFile.offset, curFile.cSize, stored});
+        }
+      };
+
       if (!processed) { // compressed with failed ratio or uncompressed data
         if (compressedSize != streamSize && verbosityLevel) {
           printline("Ratio fail "
@@ -230,49 +508,74 @@ struct ArcMakeContext : AppPackContext {
           compressedSize = CompressData(buffer, 0);
         } else { // compressed with failed ratio
           compressedSize = streamSize;
-          streamStore.WriteBuffer(buffer.data(), compressedSize);
+          WriteData(buffer, true);
           return;
         }
       }
 
-      streamStore.WriteBuffer(outBuffer.data(), compressedSize);
-    }();
+      // Small PS3 files are kept as they are in outBuffer
+      WriteData(outBuffer, compressedSize == streamSize &&
+                               settings.platform == revil::Platform::PS3);
+    };
+
+    try {
+      StoreData();
+    } catch (...) {
+      if (ownsBlob) {
+        blobPromise.set_exception(std::current_exception());
+      }
 
-    curFile.cSize = compressedSize;
-    tStream->files.emplace_back(std::move(curFile));
+      throw;
+    }
   }
 
   void Finish() override {
-    BinWritter wr(outArc);
+    if (base) {
+      // Duplicate paths of base are emitted only once, first one wins
+      std::set<std::string_view> emittedPaths;
+
+      for (auto e : usedBaseEntries) {
+        emittedPaths.emplace(e->path);
+      }
+
+      auto baseEntries = base->Entries();
+
+      for (size_t i = 0; i < baseEntries.size(); i++) {
+        auto &entry = baseEntries[i];
+
+        if (!emittedPaths.emplace(entry.path).second) {
+          continue;
+        }
+
+        AFile curFile;
+        curFile.hash = entry.typeHash;
+        curFile.uSize = entry.uncompressedSize;
+        curFile.path = entry.name;
+
+        if (!baseHashes.empty() && baseHashes[i].valid &&
+            baseHashes[i].uSize == entry.uncompressedSize) {
+          curFile.contentHash = baseHashes[i].contentHash;
+          curFile.hasContentHash = true;
+        }
+
+        CopyBaseEntry(entry, std::move(curFile));
+      }
+    }
+
+    const size_t dataEnd = wr.Tell();
+
     ARCBase arc;
-    arc.numFiles = numFiles;
+    arc.numFiles = files.size();
     arc.version = ts->arc.version;
+    wr.Seek(0);
 
-    if (arc.version < 10 || (ts->arc.flags & revil::DbArc_XMemCompress)) {
+    if (HeaderSize() == sizeof(ARCBase)) {
       wr.Write(arc);
     } else {
       ARC arcEx{arc};
       wr.Write(arcEx);
     }
 
-    const size_t dataOffset =
-        wr.Tell() + arc.numFiles * ((ts->arc.flags & revil::DbArc_ExtendedPath)
-                                        ? sizeof(ARCExtendedFile)
-                                        : sizeof(ARCFile));
-
-    std::vector<AFile> files;
-    size_t curOffset = dataOffset;
-
-    for (auto &[_, stream] : streams) {
-      auto &tFiles = stream.files;
-      std::transform(tFiles.begin(), tFiles.end(), std::back_inserter(files),
-                     [&](auto &&item) {
-                       item.offset += curOffset;
-                       return std::move(item);
-                     });
-      curOffset = tFiles.back().cSize + tFiles.back().offset;
-    }
-
     auto WriteFile = [&](auto cFile, auto &f) {
       cFile.offset = f.offset;
       cFile.typeHash = f.hash;
@@ -296,30 +599,64 @@ struct ArcMakeContext : AppPackContext {
       }
     }
 
-    for (auto &[_, stream] : streams) {
-      es::Dispose(stream.streamStore);
-      BinReader_t<BinCoreOpenMode::NoBuffer> rd(stream.streamPath);
-      const size_t fSize = rd.GetSize();
-      char buffer[0x80000];
-      const size_t numBlocks = fSize / sizeof(buffer);
-      const size_t restBytes = fSize % sizeof(buffer);
-
-      for (size_t b = 0; b < numBlocks; b++) {
-        rd.Read(buffer);
-        wr.Write(buffer);
-      }
+    es::Dispose(wr);
 
-      if (restBytes) {
-        rd.ReadBuffer(buffer, restBytes);
-        wr.WriteBuffer(buffer, restBytes);
-      }
+    if (settings.contentHashes) {
+      AHashesHeader hdr{
+          .archiveSize = dataEnd,
+          .archiveModTime = std::filesystem::last_write_time(outPath)
+                                .time_since_epoch()
+                                .count(),
+          .numEntries = uint32(files.size()),
+      };
+      BinWritter hashesWr(outPath + ".hashes");
+      hashesWr.Write(hdr);
 
-      es::Dispose(rd);
-      es::RemoveFile(stream.streamPath);
+      for (auto &f : files) {
+        hashesWr.Write(AHashesEntry{
+            .contentHash = f.contentHash,
+            .uSize = f.uSize,
+            .valid = f.hasContentHash,
+        });
+      }
     }
   }
 };
 
+// Returns empty list if hashes are missing or don't belong to archive
+static std::vector<AHashesEntry> LoadHashes(const std::string &archivePath,
+                                            size_t numEntries) {
+  const std::string hashesPath = archivePath + ".hashes";
+  std::vector<AHashesEntry> retVal;
+
+  if (!std::filesystem::exists(hashesPath)) {
+    return retVal;
+  }
+
+  BinReader rd(hashesPath);
+  AHashesHeader hdr;
+  const bool validSize =
+      rd.GetSize() == sizeof(hdr) + numEntries * sizeof(AHashesEntry);
+
+  if (validSize) {
+    rd.Read(hdr);
+  }
+
+  if (!validSize || hdr.id != AHashesHeader::ID ||
+      hdr.version != AHashesHeader::VERSION || hdr.numEntries != numEntries ||
+      hdr.archiveSize != std::filesystem::file_size(archivePath) ||
+      hdr.archiveModTime != std::filesystem::last_write_time(archivePath)
+                                .time_since_epoch()
+                                .count()) {
+    printwarning("Ignored stale " << hashesPath);
+    return retVal;
+  }
+
+  rd.ReadContainer(retVal, numEntries);
+
+  return retVal;
+}
+
 AppPackContext *AppNewArchive(const std::string &folder) {
   auto file = folder;
   while (file.back() == '/') {
@@ -327,5 +664,43 @@ AppPackContext *AppNewArchive(const std::string &folder) {
   }
 
   file += ".arc";
-  return new ArcMakeContext(file);
+
+  DirectoryScanner sc;
+  sc.Scan(folder);
+  size_t maxFiles = 0;
+  std::set<std::string> folderPaths;
+
+  for (auto &f : sc) {
+    maxFiles++;
+    folderPaths.emplace(NormalizeArcPath(
+        std::filesystem::path(f).lexically_relative(folder).generic_string()));
+  }
+
+  std::unique_ptr<revil::ArcReader> base;
+  std::vector<AHashesEntry> baseHashes;
+
+  if (!settings.baseArchive.empty()) {
+    std::error_code ec;
+
+    if (std::filesystem::equivalent(settings.baseArchive, file, ec)) {
+      throw es::RuntimeError("Base archive cannot be overwritten by output.");
+    }
+
+    base = std::make_unique<revil::ArcReader>(
+        settings.baseArchive, settings.platform, settings.title);
+
+    // Base paths replaced by folder files and duplicates are emitted once
+    std::set<std::string_view> basePaths;
+
+    for (auto &e : base->Entries()) {
+      if (!folderPaths.contains(e.path) && basePaths.emplace(e.path).second) {
+        maxFiles++;
+      }
+    }
+
+    baseHashes = LoadHashes(settings.baseArchive, base->Entries().size());
+  }
+
+  return new ArcMakeContext(file, maxFiles, std::move(base),
+                            std::move(baseHashes));
 }
@@ -0,0 +1,120 @@
+/*  HashSearch
+    Copyright(C) 2026 Lukas Cone
+
+    This program is free software : you can redistribute it and / or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "project.h"
+#include "re_common.hpp"
+#include "revil/hash_search.hpp"
+#include "spike/master_printer.hpp"
+#include <mutex>
+
+static struct HashSearch : ReflectorBase<HashSearch> {
+  std::string targets;
+  std::string prefixes;
+  std::string suffixes;
+  uint32 maxTokens = 2;
+  uint32 numThreads = 0;
+  bool searchV1 = true;
+  bool searchV2 = true;
+} settings;
+
+REFLECT(CLASS(HashSearch),
+        MEMBER(targets, "t",
+               ReflDesc{"Comma separated hexadecimal hashes to search for."}),
+        MEMBERNAME(prefixes, "prefixes",
+                   ReflDesc{"Comma separated known name prefixes."}),
+        MEMBERNAME(suffixes, "suffixes",
+                   ReflDesc{"Comma separated known name suffixes."}),
+        MEMBERNAME(maxTokens, "max-tokens",
+                   ReflDesc{"Maximum number of wordlist tokens between "
+                            "prefix and suffix."}),
+        MEMBERNAME(numThreads, "threads",
+                   ReflDesc{"Number of search threads. 0 = use all cores."}),
+        MEMBERNAME(searchV1, "v1", ReflDesc{"Search MTHashV1 hashes."}),
+        MEMBERNAME(searchV2, "v2", ReflDesc{"Search MTHashV2 hashes."}));
+
+std::string_view filters[]{
+    ".txt$",
+};
+
+static AppInfo_s appInfo{
+    .filteredLoad = true,
+    .header = HashSearch_DESC " v" HashSearch_VERSION ", " HashSearch_COPYRIGHT
+                              "Lukas Cone",
+    .settings = reinterpret_cast<ReflectorFriend *>(&settings),
+    .filters = filters,
+};
+
+AppInfo_s *AppInitModule() { return &appInfo; }
+
+static std::vector<std::string> TOKENS;
+static std::mutex TOKENS_MUTEX;
+
+// Wordlist, one token per line
+void AppProcessFile(AppContext *ctx) {
+  std::istream &str = ctx->GetStream();
+  std::vector<std::string> tokens;
+  std::string line;
+
+  while (std::getline(str, line)) {
+    std::string_view token = es::TrimWhitespace(line);
+
+    if (!token.empty()) {
+      tokens.emplace_back(token);
+    }
+  }
+
+  std::lock_guard<std::mutex> lg(TOKENS_MUTEX);
+  TOKENS.insert(TOKENS.end(), tokens.begin(), tokens.end());
+}
+
+void AppFinishContext() {
+  std::vector<uint32> targets;
+  SplitList(settings.targets, [&](std::string_view sub) {
+    if (!sub.empty()) {
+      targets.emplace_back(strtoul(std::string(sub).c_str(), nullptr, 16));
+    }
+  });
+
+  if (targets.empty()) {
+    printerror("No target hashes specified.");
+    return;
+  }
+
+  revil::HashSearchSettings searchSettings{
+      .tokens = std::move(TOKENS),
+      .maxTokens = settings.maxTokens,
+      .numThreads = settings.numThreads,
+      .searchV1 = settings.searchV1,
+      .searchV2 = settings.searchV2,
+  };
+
+  auto AddItems = [](std::string_view list, std::vector<std::string> &items) {
+    SplitList(list, [&](std::string_view sub) { items.emplace_back(sub); });
+  };
+
+  AddItems(settings.prefixes, searchSettings.prefixes);
+  AddItems(settings.suffixes, searchSettings.suffixes);
+
+  auto results = revil::SearchHashes(
+      targets, searchSettings, [](const revil::HashSearchResult &result) {
+        printline((result.isV1 ? "V1 " : "V2 ")
+                  << std::hex << std::uppercase << result.hash << " "
+                  << result.name);
+      });
+
+  printline("Found " << std::dec << results.size() << " candidates.");
+}
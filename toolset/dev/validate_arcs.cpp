@@ -19,21 +19,32 @@
 #include "hfs.hpp"
 #include "project.h"
 #include "re_common.hpp"
+#include "revil/arc.hpp"
 #include "revil/hashreg.hpp"
 #include "spike/crypto/blowfish.h"
 #include "spike/io/fileinfo.hpp"
 #include "spike/master_printer.hpp"
+#include <iomanip>
+#include <optional>
 #include <set>
 
 static struct ValidateVFS : ReflectorBase<ValidateVFS> {
   std::string title;
   Platform platform = Platform::Auto;
+  bool verify = false;
+  uint32 numThreads = 0;
 } settings;
 
 REFLECT(CLASS(ValidateVFS),
         MEMBER(title, "t", ReflDesc{"Set title for correct archive handling."}),
         MEMBER(platform, "p",
-               ReflDesc{"Set platform for correct archive handling."}));
+               ReflDesc{"Set platform for correct archive handling."}),
+        MEMBER(verify, "V",
+               ReflDesc{"Decompress every entry and check its size and "
+                        "placement, instead of checking class hashes."}),
+        MEMBERNAME(numThreads, "threads",
+                   ReflDesc{"Number of decompression threads per archive in "
+                            "verify mode. 0 = use all cores."}));
 
 std::string_view filters[]{
     ".arc$",
@@ -73,17 +84,48 @@ std::map<uint32, std::string> newHashes;
 std::map<uint32, std::string> missingHashes;
 std::set<uint32> usedHashes;
 std::mutex mergeMtx;
+size_t numCorruptedArchives = 0;
+uint64 totalUncompressedBytes = 0;
+
+void VerifyArchive(AppContext *ctx) {
+  revil::ArcReader reader(ctx->GetStream(), settings.platform, settings.title);
+  revil::ArcVerifyReport report = reader.Verify(settings.numThreads);
+  auto entries = reader.Entries();
+  const std::string archivePath(ctx->workingFile.GetFullPath());
+
+  std::lock_guard<std::mutex> lg(mergeMtx);
+  totalUncompressedBytes += report.uncompressedBytes;
+
+  for (auto &issue : report.issues) {
+    printerror(archivePath << ": " << entries[issue.entry].path << ": "
+                           << issue.message);
+  }
+
+  if (!report.issues.empty()) {
+    numCorruptedArchives++;
+  }
+
+  printline(archivePath << ": " << report.numEntries << " entries, "
+                        << report.issues.size() << " issues, "
+                        << std::fixed << std::setprecision(2)
+                        << report.Throughput() << " MB/s");
+}
 
 void AppProcessFile(AppContext *ctx) {
-  std::stringstream backup;
+  if (settings.verify) {
+    VerifyArchive(ctx);
+    return;
+  }
+
+  std::optional<HFSStream> hfs;
   uint32 id;
   ctx->GetType(id);
   ARC hdr;
   BinReaderRef_e rd(ctx->GetStream());
 
   if (id == SFHID) {
-    backup = ProcessHFS(rd);
-    rd = BinReaderRef_e(backup);
+    hfs.emplace(rd);
+    rd = BinReaderRef_e(*hfs);
     rd.Push();
     rd.Read(id);
     rd.Pop();
@@ -92,18 +134,18 @@ void AppProcessFile(AppContext *ctx) {
   std::map<uint32, std::string> newHashes;
   std::map<uint32, std::string> missingHashes;
   std::set<uint32> usedHashes;
+  const revil::TitleContext titleCtx(settings.title, settings.platform);
 
   auto WriteFiles = [&](auto &files) {
     for (auto &f : files) {
-      auto ext =
-          revil::GetExtension(f.typeHash, settings.title, settings.platform);
+      auto ext = titleCtx.GetExtension(f.typeHash);
 
       if (ext.empty()) {
         if (!newHashes.count(f.typeHash) && !::newHashes.count(f.typeHash)) {
           newHashes[f.typeHash] = f.fileName;
         }
       } else {
-        auto retHash = revil::GetHash(ext, settings.title, settings.platform);
+        auto retHash = titleCtx.GetHash(ext);
 
         if (retHash.empty()) {
           if (!missingHashes.count(f.typeHash) &&
@@ -164,6 +206,13 @@ void RE_EXTERN CheckCollisions();
 #endif
 
 void AppFinishContext() {
+  if (settings.verify) {
+    printline("Verified " << (totalUncompressedBytes >> 20) << " MB, "
+                          << numCorruptedArchives
+                          << " corrupted archives.");
+    return;
+  }
+
   if (!newHashes.empty()) {
     printline("New hashes:");
 
@@ -20,7 +20,7 @@
 #include "spike/app_context.hpp"
 #include "spike/except.hpp"
 #include "spike/io/binreader_stream.hpp"
-#include <sstream>
+#include <optional>
 
 std::string_view filters[]{
     ".dat$",
@@ -36,7 +36,7 @@ static AppInfo_s appInfo{
 AppInfo_s *AppInitModule() { return &appInfo; }
 
 void AppProcessFile(AppContext *ctx) {
-  std::stringstream backup;
+  std::optional<HFSStream> hfs;
   BinReaderRef_e rd(ctx->GetStream());
   uint32 id;
   rd.Push();
@@ -44,8 +44,8 @@ void AppProcessFile(AppContext *ctx) {
 
   if (id == SFHID) {
     rd.Pop();
-    backup = ProcessHFS(rd);
-    rd = BinReaderRef_e(backup);
+    hfs.emplace(rd);
+    rd = BinReaderRef_e(*hfs);
     rd.Push();
     rd.Read(id);
   }
@@ -19,6 +19,8 @@
 #include "revil/platform.hpp"
 #include "spike/app_context.hpp"
 #include "spike/reflect/reflector.hpp"
+#include "spike/util/supercore.hpp"
+#include <string_view>
 
 using namespace revil;
 
@@ -26,3 +28,19 @@ REFLECT(ENUMERATION(Platform), ENUM_MEMBER(Auto), ENUM_MEMBER(Win32),
         ENUM_MEMBER(PS3), ENUM_MEMBER(X360), ENUM_MEMBER(N3DS),
         ENUM_MEMBER(CAFE), ENUM_MEMBER(NSW), ENUM_MEMBER(PS4),
         ENUM_MEMBER(Android), ENUM_MEMBER(IOS), ENUM_MEMBER(Win64));
+
+// Calls callback for every trimmed item of comma separated list
+template <class C> void SplitList(std::string_view sv, C &&callback) {
+  size_t lastPost = 0;
+  auto found = sv.find(',');
+
+  while (found != sv.npos) {
+    callback(es::TrimWhitespace(sv.substr(lastPost, found - lastPost)));
+    lastPost = ++found;
+    found = sv.find(',', lastPost);
+  }
+
+  if (lastPost < sv.size()) {
+    callback(es::TrimWhitespace(sv.substr(lastPost)));
+  }
+}
@@ -425,6 +425,7 @@ void DoLmt(LMTGLTF &main, LMT &lmt, std::string name, ReportType &report) {
     AnimEngine engine;
     LinkNodes(engine, main);
     engine.numSamples = times.size();
+    std::vector<Vector4A16> values(times.size());
 
     for (auto t : *m) {
       size_t index = t->BoneIndex();
@@ -451,10 +452,9 @@ void DoLmt(LMTGLTF &main, LMT &lmt, std::string name, ReportType &report) {
         }
         aNode.positions.reserve(times.size());
         aNode.positionCompression = tm->CompressionType();
+        tm->GetValues(values, times);
 
-        for (auto k : times) {
-          Vector4A16 value;
-          t->GetValue(value, k);
+        for (auto value : values) {
           value *= SCALE;
           aNode.positions.emplace_back(value);
         }
@@ -466,10 +466,9 @@ void DoLmt(LMTGLTF &main, LMT &lmt, std::string name, ReportType &report) {
         }
         aNode.rotations.reserve(times.size());
         aNode.rotationCompression = tm->CompressionType();
+        tm->GetValues(values, times);
 
-        for (auto k : times) {
-          Vector4A16 value;
-          t->GetValue(value, k);
+        for (auto &value : values) {
           aNode.rotations.emplace_back(Pack(value));
         }
         break;
@@ -480,12 +479,8 @@ void DoLmt(LMTGLTF &main, LMT &lmt, std::string name, ReportType &report) {
         }
         aNode.scales.reserve(times.size());
         aNode.scaleCompression = tm->CompressionType();
-
-        for (auto k : times) {
-          Vector4A16 value;
-          t->GetValue(value, k);
-          aNode.scales.emplace_back(value);
-        }
+        tm->GetValues(values, times);
+        aNode.scales.insert(aNode.scales.end(), values.begin(), values.end());
         break;
       default:
         break;
@@ -9,6 +9,7 @@
 #include "spike/uni/motion.hpp"
 #include "spike/uni/rts.hpp"
 #include "spike/uni/skeleton.hpp"
+#include <algorithm>
 #include <nlohmann/json.hpp>
 
 std::string_view filters[]{
@@ -124,6 +125,37 @@ void MOTGLTF::MakeKeyBuffers(const uni::MotionsConst &anims) {
   CommonStream().wr.Write(0.f);
 }
 
+// Serves batch sampled values to gltfutils::StripValues,
+// times outside of sampled range are passed to original track
+class SampledTrack : public uni::MotionTrack {
+public:
+  SampledTrack(const uni::MotionTrack &track_,
+               std::span<const Vector4A16> values_,
+               std::span<const float> times_)
+      : track(track_), values(values_), times(times_) {}
+
+  TrackType_e TrackType() const override { return track.TrackType(); }
+  size_t BoneIndex() const override { return track.BoneIndex(); }
+
+  void GetValue(Vector4A16 &output, float time) const override {
+    auto sampledTimes = times.first(values.size());
+    auto found =
+        std::lower_bound(sampledTimes.begin(), sampledTimes.end(), time);
+
+    if (found != sampledTimes.end() && *found == time) {
+      output = values[std::distance(sampledTimes.begin(), found)];
+      return;
+    }
+
+    track.GetValue(output, time);
+  }
+
+private:
+  const uni::MotionTrack &track;
+  std::span<const Vector4A16> values;
+  std::span<const float> times;
+};
+
 void MOTGLTF::ProcessAnimation(const uni::Motion *anim) {
   gltf::Animation animation;
   animation.name = anim->Name();
@@ -134,13 +166,24 @@ void MOTGLTF::ProcessAnimation(const uni::Motion *anim) {
   const float duration = anim->Duration();
   size_t upperLimit = gltfutils::FindTimeEndIndex(times, duration);
   auto &aniStream = NewStream(anim->Name() + "-data");
+  std::vector<Vector4A16> values(upperLimit);
 
   for (auto a : *anim) {
     if (!boneRemaps.contains(a->BoneIndex())) {
       continue;
     }
 
-    auto stripResult = gltfutils::StripValues(times, upperLimit, a.get());
+    auto StripTrack = [&] {
+      if (auto reTrack = dynamic_cast<const revil::REMotionTrack *>(a.get())) {
+        reTrack->GetValues(values, times);
+        SampledTrack sampled(*reTrack, values, times);
+        return gltfutils::StripValues(times, upperLimit, &sampled);
+      }
+
+      return gltfutils::StripValues(times, upperLimit, a.get());
+    };
+
+    auto stripResult = StripTrack();
     const size_t numSamples = stripResult.values.size();
     size_t keyAccessIndex = keyAccessor;
     const bool isVec3 = a->TrackType() != uni::MotionTrack::Rotation;
@@ -17,6 +17,7 @@
 */
 
 #include "project.h"
+#include "revil/decompressor.hpp"
 #include "spike/app_context.hpp"
 #include "spike/except.hpp"
 #include "spike/io/binreader_stream.hpp"
@@ -24,103 +25,6 @@
 #include "spike/type/pointer.hpp"
 #include <sstream>
 
-#include "lzx.h"
-#include "mspack.h"
-
-#pragma region XMemDecompress
-
-struct mspack_file {
-  uint8 *buffer;
-  uint32 bufferSize;
-  uint32 position;
-  uint32 rest;
-};
-
-// https://github.com/gildor2/UEViewer/blob/master/Unreal/UnCoreCompression.cpp#L90
-static int mspack_read(mspack_file *file, void *buffer, int bytes) {
-  if (!file->rest) {
-    // read block header
-    if (file->buffer[file->position] == 0xFF) {
-      // [0]   = FF
-      // [1,2] = uncompressed block size
-      // [3,4] = compressed block size
-      file->rest = (file->buffer[file->position + 3] << 8) |
-                   file->buffer[file->position + 4];
-      file->position += 5;
-    } else {
-      // [0,1] = compressed size
-      file->rest = (file->buffer[file->position + 0] << 8) |
-                   file->buffer[file->position + 1];
-      file->position += 2;
-    }
-
-    if (file->rest > file->bufferSize - file->position) {
-      file->rest = file->bufferSize - file->position;
-    }
-  }
-
-  if (bytes > file->rest) {
-    bytes = file->rest;
-  }
-
-  if (bytes <= 0) {
-    return 0;
-  }
-
-  memcpy(buffer, file->buffer + file->position, bytes);
-  file->position += bytes;
-  file->rest -= bytes;
-
-  return bytes;
-}
-
-static int mspack_write(mspack_file *file, void *buffer, int bytes) {
-  if (bytes <= 0) {
-    return 0;
-  }
-
-  memcpy(file->buffer + file->position, buffer, bytes);
-  file->position += bytes;
-  return bytes;
-}
-
-static mspack_system mspackSystem{
-    nullptr,                                                     // open
-    nullptr,                                                     // close
-    mspack_read,                                                 // read
-    mspack_write,                                                // write
-    nullptr,                                                     // seek
-    nullptr,                                                     // tell
-    nullptr,                                                     // message
-    [](mspack_system *, size_t bytes) { return malloc(bytes); }, // alloc
-    free,                                                        // free
-    [](void *src, void *dst, size_t bytes) { memcpy(dst, src, bytes); }, // copy
-};
-
-static void DecompressLZX(char *inBuffer, uint32 compressedSize,
-                          char *outBuffer, uint32 uncompressedSize) {
-  mspack_file inStream{};
-  mspack_file outStream{};
-  inStream.buffer = reinterpret_cast<uint8 *>(inBuffer);
-  inStream.bufferSize = compressedSize;
-  outStream.buffer = reinterpret_cast<uint8 *>(outBuffer);
-  outStream.bufferSize = uncompressedSize;
-
-  lzxd_stream *lzxd = lzxd_init(&mspackSystem, &inStream, &outStream, 17, 0,
-                                0x40000, uncompressedSize, false);
-
-  int retVal = lzxd_decompress(lzxd, uncompressedSize);
-
-  if (retVal != MSPACK_ERR_OK) {
-    throw std::runtime_error("LZX decompression error " +
-                             std::to_string(retVal));
-  }
-
-  lzxd_free(lzxd);
-}
-
-#pragma endregion
-
 std::string_view filters[]{
     //".udas$",
     ".udas.lfs$",
@@ -289,13 +193,16 @@ void AppProcessFile(AppContext *ctx) {
     char inBuffer[0x10000];
     char outBuffer[0x10000];
     std::stringstream backup;
+    auto &decomp = revil::Decompressor::ThreadLocal();
 
     for (auto &c : chunks) {
       rd.Seek(c.offset + sizeof(hdr) + 3);
       rd.ReadBuffer(inBuffer, c.compressedSize);
       uint32 uncompressedSize =
           c.uncompressedSize ? c.uncompressedSize : sizeof(outBuffer);
-      DecompressLZX(inBuffer, c.compressedSize, outBuffer, uncompressedSize);
+      decomp.Decompress(revil::CompressionType::XMemLZX,
+                        {inBuffer, c.compressedSize}, outBuffer,
+                        uncompressedSize);
       backup.write(outBuffer, uncompressedSize);
     }
 